@@ -0,0 +1,261 @@
+// Copyright (c) zcbenz.
+// Licensed under the MIT License.
+
+// Each benchmark is implemented twice, once with kizunapi and once with raw
+// Node-API, so the overhead of the binding layer can be compared.
+
+#include <kizunapi.h>
+
+#include <string>
+
+namespace {
+
+class Counter {
+ public:
+  int Increment(int n) {
+    value_ += n;
+    return value_;
+  }
+
+  int value() const { return value_; }
+
+ private:
+  int value_ = 0;
+};
+
+// Subclasses of Counter, objects of them are passed as Counter* arguments.
+template<int i>
+class SubCounter : public Counter {};
+
+void Noop() {}
+
+int Add(int a, int b) {
+  return a + b;
+}
+
+std::string EchoString(std::string str) {
+  return str;
+}
+
+void CallCallback(const std::function<void(int)>& callback, int times) {
+  for (int i = 0; i < times; ++i)
+    callback(i);
+}
+
+int GetValue(Counter* counter) {
+  return counter->value();
+}
+
+}  // namespace
+
+namespace ki {
+
+template<>
+struct Type<Counter> {
+  static constexpr const char* name = "Counter";
+  static Counter* Constructor() {
+    return new Counter;
+  }
+  static void Destructor(Counter* ptr) {
+    delete ptr;
+  }
+  static void Define(napi_env env, napi_value, napi_value prototype) {
+    Set(env, prototype, "increment", &Counter::Increment);
+    DefineProperties(env, prototype,
+                     Property("value", Getter(&Counter::value)));
+  }
+};
+
+template<int i>
+struct Type<SubCounter<i>> {
+  using Base = Counter;
+  static constexpr const char* name = "SubCounter";
+  static SubCounter<i>* Constructor() {
+    return new SubCounter<i>;
+  }
+  static void Destructor(SubCounter<i>* ptr) {
+    delete ptr;
+  }
+};
+
+}  // namespace ki
+
+namespace raw {
+
+napi_value Noop(napi_env env, napi_callback_info info) {
+  return nullptr;
+}
+
+napi_value Add(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+  int32_t a, b;
+  if (argc < 2 ||
+      napi_get_value_int32(env, argv[0], &a) != napi_ok ||
+      napi_get_value_int32(env, argv[1], &b) != napi_ok) {
+    napi_throw_type_error(env, nullptr, "Invalid arguments.");
+    return nullptr;
+  }
+  napi_value result;
+  napi_create_int32(env, a + b, &result);
+  return result;
+}
+
+napi_value EchoString(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value arg;
+  napi_get_cb_info(env, info, &argc, &arg, nullptr, nullptr);
+  size_t length;
+  if (argc < 1 ||
+      napi_get_value_string_utf8(env, arg, nullptr, 0, &length) != napi_ok) {
+    napi_throw_type_error(env, nullptr, "Invalid arguments.");
+    return nullptr;
+  }
+  std::string str(length, '\0');
+  napi_get_value_string_utf8(env, arg, str.data(), length + 1, nullptr);
+  napi_value result;
+  napi_create_string_utf8(env, str.data(), str.length(), &result);
+  return result;
+}
+
+napi_value CallCallback(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2];
+  napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr);
+  int32_t times;
+  if (argc < 2 || napi_get_value_int32(env, argv[1], &times) != napi_ok) {
+    napi_throw_type_error(env, nullptr, "Invalid arguments.");
+    return nullptr;
+  }
+  napi_value undefined;
+  napi_get_undefined(env, &undefined);
+  for (int32_t i = 0; i < times; ++i) {
+    napi_handle_scope scope;
+    napi_open_handle_scope(env, &scope);
+    napi_value arg, result;
+    napi_create_int32(env, i, &arg);
+    napi_call_function(env, undefined, argv[0], 1, &arg, &result);
+    napi_close_handle_scope(env, scope);
+  }
+  return nullptr;
+}
+
+Counter* UnwrapCounter(napi_env env, napi_callback_info info,
+                       size_t* argc, napi_value* argv) {
+  napi_value self;
+  napi_get_cb_info(env, info, argc, argv, &self, nullptr);
+  void* ptr = nullptr;
+  if (napi_unwrap(env, self, &ptr) != napi_ok) {
+    napi_throw_type_error(env, nullptr, "Invalid this.");
+    return nullptr;
+  }
+  return static_cast<Counter*>(ptr);
+}
+
+napi_value CounterConstructor(napi_env env, napi_callback_info info) {
+  napi_value self;
+  napi_get_cb_info(env, info, nullptr, nullptr, &self, nullptr);
+  napi_wrap(env, self, new Counter, [](napi_env, void* ptr, void*) {
+    delete static_cast<Counter*>(ptr);
+  }, nullptr, nullptr);
+  return nullptr;
+}
+
+napi_value CounterIncrement(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value arg;
+  Counter* counter = UnwrapCounter(env, info, &argc, &arg);
+  if (!counter)
+    return nullptr;
+  int32_t n;
+  if (argc < 1 || napi_get_value_int32(env, arg, &n) != napi_ok) {
+    napi_throw_type_error(env, nullptr, "Invalid arguments.");
+    return nullptr;
+  }
+  napi_value result;
+  napi_create_int32(env, counter->Increment(n), &result);
+  return result;
+}
+
+napi_value CounterValue(napi_env env, napi_callback_info info) {
+  size_t argc = 0;
+  Counter* counter = UnwrapCounter(env, info, &argc, nullptr);
+  if (!counter)
+    return nullptr;
+  napi_value result;
+  napi_create_int32(env, counter->value(), &result);
+  return result;
+}
+
+napi_value GetValue(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value arg;
+  napi_get_cb_info(env, info, &argc, &arg, nullptr, nullptr);
+  void* ptr = nullptr;
+  if (argc < 1 || napi_unwrap(env, arg, &ptr) != napi_ok) {
+    napi_throw_type_error(env, nullptr, "Invalid arguments.");
+    return nullptr;
+  }
+  napi_value result;
+  napi_create_int32(env, static_cast<Counter*>(ptr)->value(), &result);
+  return result;
+}
+
+napi_value Create(napi_env env) {
+  napi_value exports;
+  napi_create_object(env, &exports);
+  napi_property_descriptor counter_properties[] = {
+    {"increment", nullptr, CounterIncrement, nullptr, nullptr, nullptr,
+     napi_default, nullptr},
+    {"value", nullptr, nullptr, CounterValue, nullptr, nullptr,
+     napi_default, nullptr},
+  };
+  napi_value counter;
+  napi_define_class(env, "Counter", NAPI_AUTO_LENGTH, CounterConstructor,
+                    nullptr, 2, counter_properties, &counter);
+  napi_property_descriptor properties[] = {
+    {"noop", nullptr, Noop, nullptr, nullptr, nullptr, napi_default, nullptr},
+    {"add", nullptr, Add, nullptr, nullptr, nullptr, napi_default, nullptr},
+    {"echoString", nullptr, EchoString, nullptr, nullptr, nullptr,
+     napi_default, nullptr},
+    {"callCallback", nullptr, CallCallback, nullptr, nullptr, nullptr,
+     napi_default, nullptr},
+    {"getValue", nullptr, GetValue, nullptr, nullptr, nullptr, napi_default,
+     nullptr},
+    {"Counter", nullptr, nullptr, nullptr, nullptr, counter, napi_default,
+     nullptr},
+    // Raw Node-API does not have subclasses.
+    {"SubCounter0", nullptr, nullptr, nullptr, nullptr, counter, napi_default,
+     nullptr},
+  };
+  napi_define_properties(env, exports, 7, properties);
+  return exports;
+}
+
+}  // namespace raw
+
+napi_value Init(napi_env env, napi_value exports) {
+  napi_value binding = ki::CreateObject(env);
+  ki::Set(env, binding,
+          "noop", &Noop,
+          "add", &Add,
+          "echoString", &EchoString,
+          "callCallback", &CallCallback,
+          "getValue", &GetValue,
+          "Counter", ki::Class<Counter>(),
+          "SubCounter0", ki::Class<SubCounter<0>>(),
+          "SubCounter1", ki::Class<SubCounter<1>>(),
+          "SubCounter2", ki::Class<SubCounter<2>>(),
+          "SubCounter3", ki::Class<SubCounter<3>>(),
+          "SubCounter4", ki::Class<SubCounter<4>>(),
+          "SubCounter5", ki::Class<SubCounter<5>>(),
+          "SubCounter6", ki::Class<SubCounter<6>>(),
+          "SubCounter7", ki::Class<SubCounter<7>>());
+  ki::Set(env, exports,
+          "ki", binding,
+          "raw", raw::Create(env));
+  return exports;
+}
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init);
@@ -0,0 +1,21 @@
+{
+  'targets': [
+    {
+      'target_name': 'ki_bench',
+      'include_dirs': [ '<!@(node -p "require(\'..\').include_dir")' ],
+      'cflags_cc': [ '-std=c++17' ],
+      'xcode_settings': { 'OTHER_CFLAGS': [ '-std=c++17' ] },
+      'msvs_settings': {
+        'VCCLCompilerTool': {
+          'AdditionalOptions': [ '/std:c++17' ],
+        },
+      },
+      'defines': [
+        'NAPI_VERSION=9',
+      ],
+      'sources': [
+        'bench.cc',
+      ],
+    }
+  ]
+}
@@ -0,0 +1,94 @@
+// Measures the per-call overhead of kizunapi against raw Node-API, and prints
+// the results as JSON:
+//   node bench [--iterations=N] [--filter=name]
+
+const bindings = require('./build/Release/ki_bench')
+
+const options = {iterations: 1000000, rounds: 5, filter: null}
+for (const arg of process.argv.slice(2)) {
+  const match = arg.match(/^--(\w+)=(.*)$/)
+  if (!match || !(match[1] in options))
+    throw new Error(`Unknown argument: ${arg}`)
+  options[match[1]] = match[1] == 'filter' ? match[2] : Number(match[2])
+}
+
+const benchmarks = {
+  'void()': (b) => {
+    const {noop} = b
+    return (n) => { for (let i = 0; i < n; ++i) noop() }
+  },
+  'int(int, int)': (b) => {
+    const {add} = b
+    return (n) => { for (let i = 0; i < n; ++i) add(i, 1) }
+  },
+  'std::string(std::string)': (b) => {
+    const {echoString} = b
+    const str = 'The quick brown fox jumps over the lazy dog'
+    return (n) => { for (let i = 0; i < n; ++i) echoString(str) }
+  },
+  'member function': (b) => {
+    const counter = new b.Counter()
+    return (n) => { for (let i = 0; i < n; ++i) counter.increment(1) }
+  },
+  'property getter': (b) => {
+    const counter = new b.Counter()
+    return (n) => { for (let i = 0; i < n; ++i) counter.value }
+  },
+  'subclass argument': (b) => {
+    // Create objects of all subclasses, the first one is checked last when
+    // the subclasses are checked one by one.
+    const counters = []
+    for (let i = 0; b[`SubCounter${i}`]; ++i)
+      counters.push(new b[`SubCounter${i}`]())
+    const {getValue} = b
+    const counter = counters[0]
+    return (n) => { for (let i = 0; i < n; ++i) getValue(counter) }
+  },
+  'base argument': (b) => {
+    const {getValue} = b
+    const counter = new b.Counter()
+    return (n) => { for (let i = 0; i < n; ++i) getValue(counter) }
+  },
+  'JS callback': (b) => {
+    const {callCallback} = b
+    const callback = () => {}
+    return (n) => callCallback(callback, n)
+  },
+}
+
+// Return the median of ns/call across rounds.
+function measure(run) {
+  const n = options.iterations
+  run(Math.min(n, 10000))  // warm up
+  const samples = []
+  for (let r = 0; r < options.rounds; ++r) {
+    const start = process.hrtime.bigint()
+    run(n)
+    samples.push(Number(process.hrtime.bigint() - start) / n)
+  }
+  samples.sort((a, b) => a - b)
+  return samples[Math.floor(samples.length / 2)]
+}
+
+const results = []
+for (const name in benchmarks) {
+  if (options.filter && !name.includes(options.filter))
+    continue
+  const ki = measure(benchmarks[name](bindings.ki))
+  const raw = measure(benchmarks[name](bindings.raw))
+  results.push({
+    name,
+    ki: Number(ki.toFixed(2)),
+    raw: Number(raw.toFixed(2)),
+    ratio: Number((ki / raw).toFixed(3)),
+  })
+}
+
+console.log(JSON.stringify({
+  node: process.version,
+  napi: process.versions.napi,
+  arch: process.arch,
+  unit: 'ns/call',
+  iterations: options.iterations,
+  results,
+}, null, 2))
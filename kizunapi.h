@@ -4,9 +4,18 @@
 #ifndef KIZUNAPI_H_
 #define KIZUNAPI_H_
 
+#include "src/async.h"
 #include "src/callback.h"
+#include "src/external_string.h"
+#include "src/owned_buffer.h"
 #include "src/prototype.h"
+#include "src/span.h"
 #include "src/std_types.h"
+#include "src/struct.h"
+#include "src/tagged.h"
+#include "src/task_runner.h"
+#include "src/threadsafe_function.h"
 #include "src/wrap_method.h"
+#include "src/wrappable.h"
 
 #endif  // KIZUNAPI_H_
@@ -4,6 +4,9 @@
 #ifndef SRC_ARGUMENTS_H_
 #define SRC_ARGUMENTS_H_
 
+#include <algorithm>
+#include <vector>
+
 #include "src/dict.h"
 #include "src/exception.h"
 
@@ -53,17 +56,39 @@ class Arguments {
   Arguments(napi_env env, napi_callback_info info) : env_(env), info_(info) {
     napi_status s = napi_get_cb_info(env, info, &argc_, NULL, NULL, NULL);
     assert(s == napi_ok);
-    argv_.resize(argc_);
-    s = napi_get_cb_info(env, info, &argc_,
-                         argv_.empty() ? nullptr : &argv_.front(),
-                         &this_, &data_);
+    heap_argv_.resize(argc_);
+    argv_ = heap_argv_.empty() ? nullptr : &heap_argv_.front();
+    capacity_ = argc_;
+    s = napi_get_cb_info(env, info, &argc_, argv_, &this_, &data_);
     assert(s == napi_ok);
   }
 
+  Arguments(const Arguments& other) {
+    *this = other;
+  }
+
+  Arguments& operator=(const Arguments& other) {
+    if (this != &other) {
+      env_ = other.env_;
+      info_ = other.info_;
+      argc_ = other.argc_;
+      capacity_ = other.capacity_;
+      heap_argv_ = other.heap_argv_;
+      // The inline storage of FixedArguments outlives the copies made during
+      // the call, so only the heap storage needs to be re-pointed.
+      argv_ = heap_argv_.empty() ? other.argv_ : &heap_argv_.front();
+      this_ = other.this_;
+      data_ = other.data_;
+      next_ = other.next_;
+      insufficient_arguments_ = other.insufficient_arguments_;
+    }
+    return *this;
+  }
+
   ~Arguments() = default;
 
   napi_value operator[](size_t index) const {
-    return index < Length() ? argv_[index] : nullptr;
+    return index < std::min(argc_, capacity_) ? argv_[index] : nullptr;
   }
 
   template<typename T>
@@ -72,7 +97,7 @@ class Arguments {
       insufficient_arguments_ = true;
       return std::nullopt;
     }
-    return FromNodeTo<T>(env_, argv_[next_++]);
+    return FromNodeTo<T>(env_, (*this)[next_++]);
   }
 
   // Like GetNext, but does not increase |next_| if conversion failed.
@@ -82,7 +107,7 @@ class Arguments {
       insufficient_arguments_ = true;
       return std::nullopt;
     }
-    auto result = FromNodeTo<T>(env_, argv_[next_]);
+    auto result = FromNodeTo<T>(env_, (*this)[next_]);
     if (result)
       next_++;
     return result;
@@ -123,7 +148,7 @@ class Arguments {
 
     ThrowTypeError(env_, "Error processing argument at index ", next_ - 1,
                          ", conversion failure from ",
-                         NodeTypeToString(env_, argv_[next_ -1]),
+                         NodeTypeToString(env_, (*this)[next_ - 1]),
                          " to ", target_type_name, ".");
   }
 
@@ -135,12 +160,27 @@ class Arguments {
   size_t Length() const { return argc_; }
   napi_env Env() const { return env_; }
 
+ protected:
+  // Used by FixedArguments to read at most |capacity| arguments into inline
+  // storage, which takes only one napi_get_cb_info call and no allocation.
+  Arguments(napi_env env, napi_callback_info info,
+            napi_value* storage, size_t capacity)
+      : env_(env), info_(info), argc_(capacity), capacity_(capacity),
+        argv_(storage) {
+    napi_status s = napi_get_cb_info(env, info, &argc_, argv_, &this_, &data_);
+    assert(s == napi_ok);
+  }
+
  private:
   napi_env env_;
   napi_callback_info info_;
 
+  // The |argc_| is the number of arguments passed from JS, which can be larger
+  // than the |capacity_| of |argv_|.
   size_t argc_ = 0;
-  std::vector<napi_value> argv_;
+  size_t capacity_ = 0;
+  napi_value* argv_ = nullptr;
+  std::vector<napi_value> heap_argv_;
   napi_value this_ = nullptr;
   void* data_ = nullptr;
 
@@ -148,6 +188,22 @@ class Arguments {
   bool insufficient_arguments_ = false;
 };
 
+// Arguments that store at most |capacity| JS arguments inline, used when the
+// arity of a native function is known at compile time. Extra arguments passed
+// from JS are counted by Length() but can not be read.
+template<size_t capacity>
+class FixedArguments : public Arguments {
+ public:
+  FixedArguments(napi_env env, napi_callback_info info)
+      : Arguments(env, info, storage_, capacity) {}
+
+  FixedArguments& operator=(const FixedArguments&) = delete;
+  FixedArguments(const FixedArguments&) = delete;
+
+ private:
+  napi_value storage_[capacity > 0 ? capacity : 1];
+};
+
 template<>
 struct Type<Arguments> {
   static constexpr const char* name = "Arguments";
@@ -0,0 +1,241 @@
+// Copyright (c) zcbenz.
+// Licensed under the MIT License.
+
+#ifndef SRC_ASYNC_H_
+#define SRC_ASYNC_H_
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+#include "src/callback.h"
+#include "src/dict.h"
+#include "src/local.h"
+
+namespace ki {
+
+// Helper to mark a function to be run in the libuv threadpool, the converted
+// JS function returns a Promise that resolves with its return value:
+//   Set(env, exports, "readFile", Async(&ReadFile));
+// The arguments are converted on the JS thread before the function is run,
+// and the JS arguments are kept alive until the Promise is settled. Arguments
+// are passed from storage destroyed on the JS thread, so prefer const
+// references over values to avoid copies.
+template<typename T>
+struct AsyncFunctionHolder {
+  T func;
+};
+
+template<typename T>
+inline AsyncFunctionHolder<T> Async(T func) {
+  return AsyncFunctionHolder<T>{std::move(func)};
+}
+
+namespace internal {
+
+// Types that can only be used on the JS thread, including the ones that call
+// into JS or release references when destroyed.
+template<typename T, typename Enable = void>
+struct IsJSThreadOnly
+    : std::bool_constant<std::is_same_v<T, napi_env> ||
+                         std::is_same_v<T, napi_value> ||
+                         std::is_same_v<T, napi_ref> ||
+                         std::is_same_v<T, napi_deferred> ||
+                         std::is_same_v<T, Arguments> ||
+                         std::is_same_v<T, Arguments*> ||
+                         std::is_same_v<T, Persistent>> {};
+
+template<typename T>
+struct IsJSThreadOnly<T, std::enable_if_t<std::is_base_of_v<Local, T>>>
+    : std::true_type {};
+
+template<typename Sig>
+struct IsJSThreadOnly<std::function<Sig>> : std::true_type {};
+
+template<typename T>
+struct IsJSThreadOnly<std::optional<T>> : IsJSThreadOnly<T> {};
+
+template<typename T>
+struct IsJSThreadOnly<std::vector<T>> : IsJSThreadOnly<T> {};
+
+template<typename... ArgTypes>
+struct IsJSThreadOnly<std::variant<ArgTypes...>>
+    : std::disjunction<IsJSThreadOnly<ArgTypes>...> {};
+
+template<typename... ArgTypes>
+struct IsJSThreadOnly<std::tuple<ArgTypes...>>
+    : std::disjunction<IsJSThreadOnly<ArgTypes>...> {};
+
+template<typename T>
+inline constexpr bool is_js_thread_only_v =
+    IsJSThreadOnly<std::decay_t<T>>::value;
+
+// Stores the converted arguments and result of one async call.
+template<typename HolderT, typename Sig>
+class AsyncWork {};
+
+template<typename HolderT, typename ReturnType, typename... ArgTypes>
+class AsyncWork<HolderT, ReturnType(ArgTypes...)> {
+ public:
+  using Sig = ReturnType(ArgTypes...);
+  using ArgsTuple =
+      std::tuple<typename CallbackParamTraits<ArgTypes>::LocalType...>;
+
+  static_assert(!(is_js_thread_only_v<ArgTypes> || ...),
+                "Functions run in threadpool can not receive JS values, "
+                "references, Arguments or JS functions.");
+  static_assert(!is_js_thread_only_v<ReturnType>,
+                "Functions run in threadpool can not return JS values, "
+                "references or JS functions.");
+
+  // The napi_callback of the JS function.
+  static napi_value Invoke(napi_env env, napi_callback_info info) {
+    typename CallbackArguments<Sig>::Type args(env, info);
+    auto* holder = static_cast<std::shared_ptr<HolderT>*>(args.Data());
+    using Indices = typename IndicesGenerator<sizeof...(ArgTypes)>::type;
+    Invoker<Indices, ArgTypes...> invoker(&args, (*holder)->flags);
+    if (!invoker.IsOK())
+      return nullptr;
+    auto work = std::make_unique<AsyncWork>(*holder, invoker.TakeArguments());
+    // Keep the JS objects passed to the function alive, which include the
+    // wrappers of native objects.
+    work->KeepAlive(env, args.This());
+    for (size_t i = 0; i < args.Length(); ++i)
+      work->KeepAlive(env, args[i]);
+    napi_value promise;
+    if (napi_create_promise(env, &work->deferred_, &promise) != napi_ok)
+      return nullptr;
+    // The promise must be settled once created.
+    napi_value resource_name;
+    napi_status s = napi_create_string_utf8(env, "Async", NAPI_AUTO_LENGTH,
+                                            &resource_name);
+    if (s == napi_ok) {
+      s = napi_create_async_work(env, nullptr, resource_name,
+                                 &Execute, &Complete, work.get(),
+                                 &work->work_);
+    }
+    if (s == napi_ok) {
+      s = napi_queue_async_work(env, work->work_);
+      if (s != napi_ok)
+        napi_delete_async_work(env, work->work_);
+    }
+    if (s != napi_ok) {
+      work->Reject(env, "Unable to queue the async work.");
+      return promise;
+    }
+    work.release();
+    return promise;
+  }
+
+  AsyncWork(std::shared_ptr<HolderT> holder, ArgsTuple args)
+      : holder_(std::move(holder)), args_(std::move(args)) {}
+
+ private:
+  void KeepAlive(napi_env env, napi_value value) {
+    if (value && internal::IsObject(env, value))
+      refs_.emplace_back(env, value);
+  }
+
+  // Run in threadpool. The arguments are passed by reference so they are only
+  // destroyed on the JS thread together with the work.
+  static void Execute(napi_env, void* data) {
+    auto* self = static_cast<AsyncWork*>(data);
+    auto call = [self](auto&... args) -> decltype(auto) {
+      return std::invoke(self->holder_->callback, args...);
+    };
+#if defined(__cpp_exceptions)
+    try {
+#endif
+      if constexpr (std::is_void_v<ReturnType>)
+        std::apply(call, self->args_);
+      else
+        self->result_ = std::apply(call, self->args_);
+#if defined(__cpp_exceptions)
+    } catch (const std::exception& e) {
+      self->error_ = e.what();
+    }
+#endif
+  }
+
+  // Reject the promise with an Error of |message|.
+  void Reject(napi_env env, const std::string& message) {
+    napi_value str, error;
+    napi_create_string_utf8(env, message.c_str(), message.length(), &str);
+    napi_create_error(env, nullptr, str, &error);
+    napi_reject_deferred(env, deferred_, error);
+  }
+
+  // Run on the JS thread after Execute.
+  static void Complete(napi_env env, napi_status status, void* data) {
+    std::unique_ptr<AsyncWork> self(static_cast<AsyncWork*>(data));
+    napi_delete_async_work(env, self->work_);
+    if (status == napi_cancelled)
+      self->error_ = "The async work has been cancelled.";
+    if (self->error_) {
+      self->Reject(env, *self->error_);
+      return;
+    }
+    napi_value result;
+    if constexpr (std::is_void_v<ReturnType>)
+      result = Undefined(env);
+    else
+      result = ToNodeValue(env, std::move(*self->result_));
+    napi_resolve_deferred(env, self->deferred_, result);
+  }
+
+  using ResultType = std::conditional_t<std::is_void_v<ReturnType>,
+                                        std::monostate,
+                                        std::decay_t<ReturnType>>;
+
+  std::shared_ptr<HolderT> holder_;
+  ArgsTuple args_;
+  std::optional<ResultType> result_;
+  std::optional<std::string> error_;
+  std::vector<Persistent> refs_;
+  napi_deferred deferred_ = nullptr;
+  napi_async_work work_ = nullptr;
+};
+
+// Create a JS function that runs |func| in threadpool.
+template<typename T>
+inline napi_status CreateAsyncNodeFunction(napi_env env, T func,
+                                           napi_value* result,
+                                           int flags = 0) {
+  using Factory = CallbackHolderFactory<T>;
+  using RunType = typename Factory::RunType;
+  using HolderT = typename Factory::HolderT;
+  // The holder is shared with the pending works so it stays alive even if the
+  // JS function is garbage collected before the works finish.
+  auto holder = std::make_unique<std::shared_ptr<HolderT>>(
+      std::make_shared<HolderT>(Factory::Create(std::move(func), flags)));
+  napi_value intermediate;
+  napi_status s = napi_create_function(
+      env, nullptr, 0, &AsyncWork<HolderT, RunType>::Invoke,
+      holder.get(), &intermediate);
+  if (s != napi_ok)
+    return s;
+  s = AddToFinalizer(env, intermediate, std::move(holder));
+  if (s != napi_ok)
+    return s;
+  *result = intermediate;
+  return napi_ok;
+}
+
+}  // namespace internal
+
+template<typename T>
+struct Type<AsyncFunctionHolder<T>> {
+  static constexpr const char* name = "Function";
+  static inline napi_status ToNode(napi_env env, AsyncFunctionHolder<T> value,
+                                   napi_value* result) {
+    return internal::CreateAsyncNodeFunction(env, std::move(value.func),
+                                             result);
+  }
+};
+
+}  // namespace ki
+
+#endif  // SRC_ASYNC_H_
@@ -13,7 +13,9 @@ class AttachedTable : public Map {
  public:
   AttachedTable() = default;
   AttachedTable(napi_env env, napi_value object)
-      : Map(InstanceData::Get(env)->GetOrCreateAttachedTable(object)) {}
+      : AttachedTable(InstanceData::Get(env), object) {}
+  AttachedTable(InstanceData* instance_data, napi_value object)
+      : Map(instance_data->GetOrCreateAttachedTable(object)) {}
   explicit AttachedTable(const Arguments& args)
       : AttachedTable(args.Env(), args.This()) {}
 };
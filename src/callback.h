@@ -52,6 +52,7 @@ template<typename ReturnType, typename... ArgTypes>
 struct Type<std::function<ReturnType(ArgTypes...)>> {
   using Sig = ReturnType(ArgTypes...);
   static constexpr const char* name = "Function";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_function);
   static inline napi_status ToNode(napi_env env,
                                    std::function<Sig> value,
                                    napi_value* result) {
@@ -75,6 +76,23 @@ struct Type<T, typename std::enable_if<
   }
 };
 
+// Bind a function or member function at compile time, for example:
+//   Set(env, prototype, "method", Fn<&Foo::Method>());
+// The JS function calls |func| directly, without allocating a holder for it.
+template<auto func, int flags = 0>
+struct Fn {};
+
+template<auto func, int flags>
+struct Type<Fn<func, flags>> {
+  static constexpr const char* name = "Function";
+  static inline napi_status ToNode(napi_env env, Fn<func, flags>,
+                                   napi_value* result) {
+    return napi_create_function(env, nullptr, 0,
+                                &internal::StaticCallback<func, flags>::Invoke,
+                                nullptr, result);
+  }
+};
+
 // Helper mark a normal function as member function.
 template<typename T>
 struct MemberFunctionHolder {
@@ -6,6 +6,8 @@
 #define SRC_CALLBACK_INTERNAL_H_
 
 #include <functional>
+#include <string_view>
+#include <tuple>
 #include <variant>
 
 #include "src/arguments.h"
@@ -21,8 +23,13 @@ enum CallbackConvertionFlags {
   FunctionArgumentIsWeakRef = 1 << 1,
 };
 
+template<typename Sig>
+class ThreadSafeFunction;
+
 namespace internal {
 
+class StringViewHolder;
+
 // Deduce the proper type for callback parameters.
 template<typename T>
 struct CallbackParamTraits {
@@ -40,6 +47,33 @@ template<>
 struct CallbackParamTraits<const char*&> {
   using LocalType = const char*;
 };
+template<>
+struct CallbackParamTraits<std::string_view> {
+  using LocalType = StringViewHolder;
+};
+template<>
+struct CallbackParamTraits<const std::string_view&> {
+  using LocalType = StringViewHolder;
+};
+
+// Check if T is a function wrapper that has its own conversion.
+template<typename T>
+struct is_function_wrapper : std::false_type {};
+
+template<typename Sig>
+struct is_function_wrapper<std::function<Sig>> : std::true_type {};
+
+template<typename Sig>
+struct is_function_wrapper<ThreadSafeFunction<Sig>> : std::true_type {};
+
+// Check if T is a lambda or functor with a non-overloaded const operator().
+template<typename T, typename Enable = void>
+struct IsCallableObject : std::false_type {};
+
+template<typename T>
+struct IsCallableObject<T, std::void_t<ExtractCallableRunType<T>>>
+    : std::integral_constant<bool, std::is_class_v<T> &&
+                                   !is_function_wrapper<T>::value> {};
 
 // The supported function types for conversion.
 template<typename T, typename Enable = void>
@@ -48,7 +82,8 @@ struct IsFunctionConversionSupported
           bool,
           is_function_pointer<T>::value ||
           std::is_function<T>::value ||
-          std::is_member_function_pointer<T>::value> {};
+          std::is_member_function_pointer<T>::value ||
+          IsCallableObject<T>::value> {};
 
 // Helper to read C++ args from JS args.
 template<typename T>
@@ -130,6 +165,48 @@ struct ArgConverter<napi_env> {
   }
 };
 
+// Choose the Arguments class used for invoking a native function: when the
+// function does not read arguments dynamically, its arity is known at compile
+// time and the arguments can be stored inline without allocation.
+template<typename Sig, size_t min_capacity = 0>
+struct CallbackArguments {};
+
+template<typename ReturnType, typename... ArgTypes, size_t min_capacity>
+struct CallbackArguments<ReturnType(ArgTypes...), min_capacity> {
+  static constexpr bool is_variadic =
+      (std::is_same_v<std::decay_t<ArgTypes>, Arguments> || ...) ||
+      (std::is_same_v<std::decay_t<ArgTypes>, Arguments*> || ...);
+  using Type = std::conditional_t<
+      is_variadic,
+      Arguments,
+      FixedArguments<std::max(sizeof...(ArgTypes), min_capacity)>>;
+};
+
+// Marks that a native function is being called from JS on current thread,
+// which means JS functions can be called synchronously without going through
+// napi_make_callback.
+class CallFromJSScope {
+ public:
+  CallFromJSScope() { ++Depth(); }
+  ~CallFromJSScope() { --Depth(); }
+
+  CallFromJSScope& operator=(const CallFromJSScope&) = delete;
+  CallFromJSScope(const CallFromJSScope&) = delete;
+
+  static bool IsActive() { return Depth() > 0; }
+
+ private:
+  static int& Depth() {
+    static thread_local int depth = 0;
+    return depth;
+  }
+};
+
+// Records whether all the arguments converted so far have succeeded.
+struct InvokerStatus {
+  bool ok = true;
+};
+
 // Class template for extracting and storing single argument for callback
 // at position |index|.
 template<size_t index, typename ArgType>
@@ -138,22 +215,31 @@ struct ArgumentHolder {
 
   std::optional<LocalType> value;
 
-  ArgumentHolder(Arguments* args, int flags)
-      : value(ArgConverter<LocalType>::GetNext(args, flags, index == 0)) {
-    if (!value)
+  // Stop converting once an argument has failed, so only one error is thrown
+  // and no time is spent on the rest of arguments.
+  ArgumentHolder(Arguments* args, int flags, InvokerStatus* status)
+      : value(status->ok ? ArgConverter<LocalType>::GetNext(args, flags,
+                                                            index == 0)
+                         : std::nullopt) {
+    if (status->ok && !value) {
       args->ThrowError(Type<LocalType>::name);
+      status->ok = false;
+    }
   }
 };
 
-// CallbackHolder holds information about a std::function.
-template<typename Sig>
+// CallbackHolder holds a callable of |Functor| type, which is stored by its
+// concrete type so invoking it does not go through type erasure.
+template<typename Sig, typename Functor = std::function<Sig>>
 struct CallbackHolder {
-  explicit CallbackHolder(std::function<Sig> callback, int flags = 0)
+  using RunType = Sig;
+
+  explicit CallbackHolder(Functor callback, int flags = 0)
       : callback(std::move(callback)), flags(flags) {}
-  CallbackHolder(const CallbackHolder<Sig>&) = default;
-  CallbackHolder(CallbackHolder<Sig>&&) = default;
+  CallbackHolder(const CallbackHolder&) = default;
+  CallbackHolder(CallbackHolder&&) = default;
 
-  std::function<Sig> callback;
+  Functor callback;
   int flags;
 };
 
@@ -174,9 +260,9 @@ template<typename T>
 struct CallbackHolderFactory<T, typename std::enable_if<
                                     is_function_pointer<T>::value>::type> {
   using RunType = typename FunctorTraits<T>::RunType;
-  using HolderT = CallbackHolder<RunType>;
+  using HolderT = CallbackHolder<RunType, T>;
   static inline HolderT Create(T func, int flags = 0) {
-    return HolderT{std::function<RunType>(func), flags};
+    return HolderT(func, flags);
   }
 };
 
@@ -185,9 +271,19 @@ struct CallbackHolderFactory<T, typename std::enable_if<
                                     std::is_member_function_pointer<
                                         T>::value>::type> {
   using RunType = typename FunctorTraits<T>::RunType;
-  using HolderT = CallbackHolder<RunType>;
+  using HolderT = CallbackHolder<RunType, T>;
+  static inline HolderT Create(T func, int flags = 0) {
+    return HolderT(func, HolderIsFirstArgument | flags);
+  }
+};
+
+template<typename T>
+struct CallbackHolderFactory<T, typename std::enable_if<
+                                    IsCallableObject<T>::value>::type> {
+  using RunType = ExtractCallableRunType<T>;
+  using HolderT = CallbackHolder<RunType, T>;
   static inline HolderT Create(T func, int flags = 0) {
-    return HolderT{std::function<RunType>(func), HolderIsFirstArgument | flags};
+    return HolderT(std::move(func), flags);
   }
 };
 
@@ -198,32 +294,39 @@ class Invoker {};
 
 template<size_t... indices, typename... ArgTypes>
 class Invoker<IndicesHolder<indices...>, ArgTypes...>
-    : public ArgumentHolder<indices, ArgTypes>... {
+    : private InvokerStatus,
+      public ArgumentHolder<indices, ArgTypes>... {
  public:
   // Invoker<> inherits from ArgumentHolder<> for each argument.
   // C++ has always been strict about the class initialization order,
   // so it is guaranteed ArgumentHolders will be initialized (and thus, will
-  // extract arguments from Arguments) in the right order.
+  // extract arguments from Arguments) in the right order, after the
+  // InvokerStatus they share.
   Invoker(Arguments* args, int flags)
-      : ArgumentHolder<indices, ArgTypes>(args, flags)..., args_(args) {}
+      : InvokerStatus(),
+        ArgumentHolder<indices, ArgTypes>(args, flags, this)...,
+        args_(args) {}
 
   bool IsOK() {
-    return And(ArgumentHolder<indices, ArgTypes>::value.has_value()...);
+    return ok;
   }
 
-  template<typename ReturnType>
-  ReturnType DispatchToCallback(
-      const std::function<ReturnType(ArgTypes...)>& callback) {
-    return callback(std::move(*ArgumentHolder<indices, ArgTypes>::value)...);
+  // Move the converted arguments out, used when the callback is not invoked
+  // immediately.
+  std::tuple<typename ArgumentHolder<indices, ArgTypes>::LocalType...>
+  TakeArguments() {
+    return std::tuple<
+        typename ArgumentHolder<indices, ArgTypes>::LocalType...>(
+            std::move(*ArgumentHolder<indices, ArgTypes>::value)...);
   }
 
- private:
-  static bool And() { return true; }
-  template<typename... T>
-  static bool And(bool arg1, T... args) {
-    return arg1 && And(args...);
+  template<typename ReturnType, typename F>
+  ReturnType DispatchToCallback(const F& callback) {
+    return std::invoke(callback,
+                       std::move(*ArgumentHolder<indices, ArgTypes>::value)...);
   }
 
+ private:
   Arguments* args_;
 };
 
@@ -234,25 +337,35 @@ struct CallbackInvoker {};
 
 template<typename ReturnType, typename... ArgTypes>
 struct CallbackInvoker<ReturnType(ArgTypes...)> {
-  using HolderT = CallbackHolder<ReturnType(ArgTypes...)>;
   using ReturnLocalType = std::optional<std::decay_t<ReturnType>>;
+  using ArgumentsT =
+      typename CallbackArguments<ReturnType(ArgTypes...)>::Type;
+  template<typename HolderT>
   static inline ReturnLocalType Invoke(napi_env env, napi_callback_info info) {
-    Arguments args(env, info);
-    return Invoke(&args);
+    ArgumentsT args(env, info);
+    return Invoke(&args, static_cast<const HolderT*>(args.Data()));
   }
+  template<typename HolderT>
   static inline ReturnLocalType Invoke(napi_env env, napi_callback_info info,
                                        const HolderT* holder) {
-    Arguments args(env, info);
+    ArgumentsT args(env, info);
     return Invoke(&args, holder);
   }
-  static inline ReturnLocalType Invoke(Arguments* args) {
-    return Invoke(args, static_cast<HolderT*>(args->Data()));
-  }
+  template<typename HolderT>
   static inline ReturnLocalType Invoke(Arguments* args,
                                        const HolderT* holder,
                                        bool* success = nullptr) {
+    return InvokeCallable(args, holder->callback, holder->flags, success);
+  }
+  // Invoke the |callback| directly, which can be any callable type matching
+  // the signature.
+  template<typename F>
+  static inline ReturnLocalType InvokeCallable(Arguments* args,
+                                               const F& callback,
+                                               int flags,
+                                               bool* success = nullptr) {
     using Indices = typename IndicesGenerator<sizeof...(ArgTypes)>::type;
-    Invoker<Indices, ArgTypes...> invoker(args, holder->flags);
+    Invoker<Indices, ArgTypes...> invoker(args, flags);
     if (!invoker.IsOK()) {
       if (success)
         *success = false;
@@ -260,10 +373,11 @@ struct CallbackInvoker<ReturnType(ArgTypes...)> {
     }
     if (success)
       *success = true;
+    CallFromJSScope call_from_js_scope;
 #if defined(__cpp_exceptions)
     try {
 #endif
-      return invoker.DispatchToCallback(holder->callback);
+      return invoker.template DispatchToCallback<ReturnType>(callback);
 #if defined(__cpp_exceptions)
     } catch (const std::exception& e) {
       ThrowError(args->Env(), e.what());
@@ -277,24 +391,31 @@ struct CallbackInvoker<ReturnType(ArgTypes...)> {
 
 template<typename... ArgTypes>
 struct CallbackInvoker<void(ArgTypes...)> {
-  using HolderT = CallbackHolder<void(ArgTypes...)>;
+  using ArgumentsT = typename CallbackArguments<void(ArgTypes...)>::Type;
+  template<typename HolderT>
   static inline void Invoke(napi_env env, napi_callback_info info) {
-    Arguments args(env, info);
-    Invoke(&args);
+    ArgumentsT args(env, info);
+    Invoke(&args, static_cast<const HolderT*>(args.Data()));
   }
+  template<typename HolderT>
   static inline void Invoke(napi_env env, napi_callback_info info,
                             const HolderT* holder) {
-    Arguments args(env, info);
+    ArgumentsT args(env, info);
     Invoke(&args, holder);
   }
-  static inline void Invoke(Arguments* args) {
-    Invoke(args, static_cast<HolderT*>(args->Data()));
-  }
+  template<typename HolderT>
   static inline void Invoke(Arguments* args,
                             const HolderT* holder,
                             bool* success = nullptr) {
+    InvokeCallable(args, holder->callback, holder->flags, success);
+  }
+  template<typename F>
+  static inline void InvokeCallable(Arguments* args,
+                                    const F& callback,
+                                    int flags,
+                                    bool* success = nullptr) {
     using Indices = typename IndicesGenerator<sizeof...(ArgTypes)>::type;
-    Invoker<Indices, ArgTypes...> invoker(args, holder->flags);
+    Invoker<Indices, ArgTypes...> invoker(args, flags);
     if (!invoker.IsOK()) {
       if (success)
         *success = false;
@@ -302,10 +423,11 @@ struct CallbackInvoker<void(ArgTypes...)> {
     }
     if (success)
       *success = true;
+    CallFromJSScope call_from_js_scope;
 #if defined(__cpp_exceptions)
     try {
 #endif
-      invoker.DispatchToCallback(holder->callback);
+      invoker.template DispatchToCallback<void>(callback);
 #if defined(__cpp_exceptions)
     } catch (const std::exception& e) {
       ThrowError(args->Env(), e.what());
@@ -319,68 +441,117 @@ struct CallbackInvoker<void(ArgTypes...)> {
 // Convert the return value of callback to napi_value.
 template<typename Sig>
 struct ReturnToNode {
+  template<typename HolderT>
   static napi_value Invoke(napi_env env, napi_callback_info info) {
-    return ToNodeValue(env, CallbackInvoker<Sig>::Invoke(env, info));
+    return ToNodeValue(env,
+                       CallbackInvoker<Sig>::template Invoke<HolderT>(env,
+                                                                      info));
   }
+  template<typename HolderT>
   static napi_value InvokeWithHolder(napi_env env, napi_callback_info info,
-                                     const CallbackHolder<Sig>* holder) {
+                                     const HolderT* holder) {
     return ToNodeValue(env, CallbackInvoker<Sig>::Invoke(env, info, holder));
   }
+  template<typename HolderT>
   static napi_value InvokeWithHolder(Arguments* args,
-                                     const CallbackHolder<Sig>* holder,
+                                     const HolderT* holder,
                                      bool* success = nullptr) {
     return ToNodeValue(args->Env(),
                   CallbackInvoker<Sig>::Invoke(args, holder, success));
   }
+  template<typename F>
+  static napi_value InvokeCallable(Arguments* args, const F& callback,
+                                   int flags) {
+    return ToNodeValue(args->Env(),
+                       CallbackInvoker<Sig>::InvokeCallable(args, callback,
+                                                            flags));
+  }
 };
 
 template<typename... ArgTypes>
 struct ReturnToNode<void(ArgTypes...)> {
   using Sig = void(ArgTypes...);
+  template<typename HolderT>
   static napi_value Invoke(napi_env env, napi_callback_info info) {
-    CallbackInvoker<Sig>::Invoke(env, info);
+    CallbackInvoker<Sig>::template Invoke<HolderT>(env, info);
     return nullptr;
   }
+  template<typename HolderT>
   static napi_value InvokeWithHolder(napi_env env, napi_callback_info info,
-                                     const CallbackHolder<Sig>* holder) {
+                                     const HolderT* holder) {
     CallbackInvoker<Sig>::Invoke(env, info, holder);
     return nullptr;
   }
+  template<typename HolderT>
   static napi_value InvokeWithHolder(Arguments* args,
-                                     const CallbackHolder<Sig>* holder,
+                                     const HolderT* holder,
                                      bool* success = nullptr) {
     CallbackInvoker<Sig>::Invoke(args, holder, success);
     return nullptr;
   }
+  template<typename F>
+  static napi_value InvokeCallable(Arguments* args, const F& callback,
+                                   int flags) {
+    CallbackInvoker<Sig>::InvokeCallable(args, callback, flags);
+    return nullptr;
+  }
 };
 
 using NodeCallbackSig = napi_value(napi_env, napi_callback_info);
 
 // Create a std::function<napi_callback> from the passed |holder|, that can be
 // executed with arbitrary napi_callback_info.
-template<typename Sig>
+template<typename HolderT>
 inline std::function<NodeCallbackSig> CreateNodeCallbackWithHolder(
-    CallbackHolder<Sig>&& holder) {
-  return [holder = std::move(holder)](napi_env env, napi_callback_info info) {
+    HolderT&& holder) {
+  using Sig = typename std::decay_t<HolderT>::RunType;
+  return [holder = std::forward<HolderT>(holder)](napi_env env,
+                                                  napi_callback_info info) {
     return ReturnToNode<Sig>::InvokeWithHolder(env, info, &holder);
   };
 }
 
+// A napi_callback that invokes a stateless lambda or functor, which is stored
+// once per type so the JS function does not need a holder, and the flags are
+// stored in the data of the JS function.
+template<typename Functor>
+struct StatelessCallback {
+  using RunType = ExtractCallableRunType<Functor>;
+  static napi_value Invoke(napi_env env, napi_callback_info info) {
+    typename CallbackArguments<RunType>::Type args(env, info);
+    int flags = static_cast<int>(reinterpret_cast<intptr_t>(args.Data()));
+    return ReturnToNode<RunType>::InvokeCallable(&args, Get(), flags);
+  }
+  // All instances of a stateless type are equivalent, so only the first one
+  // passed is stored.
+  static const Functor& Get(const Functor* func = nullptr) {
+    static const Functor instance(*func);
+    return instance;
+  }
+};
+
 // Create a JS Function that executes a provided C++ function or std::function.
 // JavaScript arguments are automatically converted via Type<T>, as is
 // the return value of the C++ function, if any.
 template<typename T>
 inline napi_status CreateNodeFunction(napi_env env, T func, napi_value* result,
                                       int flags = 0) {
+  if constexpr (IsCallableObject<T>::value && std::is_empty_v<T>) {
+    StatelessCallback<T>::Get(&func);
+    return napi_create_function(
+        env, nullptr, 0, &StatelessCallback<T>::Invoke,
+        reinterpret_cast<void*>(static_cast<intptr_t>(flags)), result);
+  }
   using Factory = CallbackHolderFactory<T>;
   using RunType = typename Factory::RunType;
   using HolderT = typename Factory::HolderT;
   auto holder = std::make_unique<HolderT>(Factory::Create(std::move(func),
                                                           flags));
   napi_value intermediate;
-  napi_status s = napi_create_function(env, nullptr, 0,
-                                       &ReturnToNode<RunType>::Invoke,
-                                       holder.get(), &intermediate);
+  napi_status s = napi_create_function(
+      env, nullptr, 0,
+      &ReturnToNode<RunType>::template Invoke<HolderT>,
+      holder.get(), &intermediate);
   if (s != napi_ok)
     return s;
   s = AddToFinalizer(env, intermediate, std::move(holder));
@@ -390,6 +561,39 @@ inline napi_status CreateNodeFunction(napi_env env, T func, napi_value* result,
   return napi_ok;
 }
 
+// A napi_callback that invokes the compile-time bound |func| directly.
+template<auto func, int flags>
+struct StaticCallback {
+  using RunType = typename FunctorTraits<decltype(func)>::RunType;
+  static constexpr int kFlags =
+      std::is_member_function_pointer_v<decltype(func)> ?
+          flags | HolderIsFirstArgument : flags;
+  static napi_value Invoke(napi_env env, napi_callback_info info) {
+    typename CallbackArguments<RunType>::Type args(env, info);
+    return ReturnToNode<RunType>::InvokeCallable(&args, func, kFlags);
+  }
+};
+
+// Call the JS |func| with |argv|. When there is already JS on the stack or a
+// batch scope open, the function is called with napi_call_function directly,
+// otherwise napi_make_callback is used so microtasks and async hooks are
+// handled.
+inline napi_status CallJSFunction(napi_env env, napi_value func,
+                                  size_t argc, const napi_value* argv,
+                                  napi_value* result) {
+  bool in_scope = CallFromJSScope::IsActive() ||
+                  CallbackBatchScope::IsActive(env);
+  napi_status s = in_scope ?
+      napi_call_function(env, func, func, argc, argv, result) :
+      napi_make_callback(env, nullptr, func, func, argc, argv, result);
+  if (s == napi_pending_exception) {
+    napi_value fatal_exception;
+    napi_get_and_clear_last_exception(env, &fatal_exception);
+    napi_fatal_exception(env, fatal_exception);
+  }
+  return s;
+}
+
 // Helper to invoke a V8 function with C++ parameters.
 template<typename Sig>
 struct V8FunctionInvoker {};
@@ -397,53 +601,56 @@ struct V8FunctionInvoker {};
 template<typename... ArgTypes>
 struct V8FunctionInvoker<void(ArgTypes...)> {
   static void Go(napi_env env, Persistent* handle, ArgTypes&&... raw) {
-    HandleScope handle_scope(env);
+    // Inside a batch the handles are freed when the batch ends.
+    if (CallbackBatchScope::IsActive(env)) {
+      Call(env, handle, std::forward<ArgTypes>(raw)...);
+    } else {
+      HandleScope handle_scope(env);
+      Call(env, handle, std::forward<ArgTypes>(raw)...);
+    }
+  }
+
+ private:
+  static void Call(napi_env env, Persistent* handle, ArgTypes&&... raw) {
     napi_value func = handle->Value();
     if (!func) {
       ThrowError(env, "The function has been garbage collected");
       return;
     }
-    std::vector<napi_value> args = {
-        ToNode(env, std::forward<ArgTypes>(raw))...
+    napi_value args[] = {
+        ToNodeValue(env, std::forward<ArgTypes>(raw))..., nullptr
     };
-    napi_status s = napi_make_callback(env, nullptr, func, func, args.size(),
-                                       args.empty() ? nullptr: &args.front(),
-                                       nullptr);
-    if (s == napi_pending_exception) {
-      napi_value fatal_exception;
-      napi_get_and_clear_last_exception(env, &fatal_exception);
-      napi_fatal_exception(env, fatal_exception);
-    }
+    CallJSFunction(env, func, sizeof...(ArgTypes), args, nullptr);
   }
 };
 
 template<typename ReturnType, typename... ArgTypes>
 struct V8FunctionInvoker<ReturnType(ArgTypes...)> {
   static ReturnType Go(napi_env env, Persistent* handle, ArgTypes&&... raw) {
+    if (CallbackBatchScope::IsActive(env))
+      return Call(env, handle, std::forward<ArgTypes>(raw)...);
     HandleScope handle_scope(env);
+    return Call(env, handle, std::forward<ArgTypes>(raw)...);
+  }
+
+ private:
+  static ReturnType Call(napi_env env, Persistent* handle, ArgTypes&&... raw) {
     ReturnType ret{};
     napi_value func = handle->Value();
     if (!func) {
       ThrowError(env, "The function has been garbage collected");
       return ret;
     }
-    std::vector<napi_value> args = {
-        ToNode(env, std::forward<ArgTypes>(raw))...
+    napi_value args[] = {
+        ToNodeValue(env, std::forward<ArgTypes>(raw))..., nullptr
     };
     napi_value value;
-    napi_status s = napi_make_callback(env, nullptr, func, func, args.size(),
-                                       args.empty() ? nullptr: &args.front(),
-                                       &value);
-    if (s == napi_ok) {
+    if (CallJSFunction(env, func, sizeof...(ArgTypes), args,
+                       &value) == napi_ok) {
       std::optional<ReturnType> result = FromNodeTo<ReturnType>(env, value);
       if (result)
         ret = std::move(*result);
     }
-    if (s == napi_pending_exception) {
-      napi_value fatal_exception;
-      napi_get_and_clear_last_exception(env, &fatal_exception);
-      napi_fatal_exception(env, fatal_exception);
-    }
     return ret;
   }
 };
@@ -451,26 +658,27 @@ struct V8FunctionInvoker<ReturnType(ArgTypes...)> {
 template<typename... ArgTypes>
 struct V8FunctionInvoker<napi_value(ArgTypes...)> {
   static napi_value Go(napi_env env, Persistent* handle, ArgTypes&&... raw) {
+    if (CallbackBatchScope::IsActive(env))
+      return Call(env, handle, std::forward<ArgTypes>(raw)...);
     EscapableHandleScope handle_scope(env);
+    napi_value result = Call(env, handle, std::forward<ArgTypes>(raw)...);
+    return result ? handle_scope.Escape(result) : nullptr;
+  }
+
+ private:
+  static napi_value Call(napi_env env, Persistent* handle, ArgTypes&&... raw) {
     napi_value func = handle->Value();
     if (!func) {
       ThrowError(env, "The function has been garbage collected");
       return nullptr;
     }
-    std::vector<napi_value> args = {
-        ToNode(env, std::forward<ArgTypes>(raw))...
+    napi_value args[] = {
+        ToNodeValue(env, std::forward<ArgTypes>(raw))..., nullptr
     };
     napi_value result;
-    napi_status s = napi_make_callback(env, nullptr, func, func, args.size(),
-                                       args.empty() ? nullptr: &args.front(),
-                                       &result);
-    if (s == napi_ok) {
-      return handle_scope.Escape(result);
-    }
-    if (s == napi_pending_exception) {
-      napi_value fatal_exception;
-      napi_get_and_clear_last_exception(env, &fatal_exception);
-      napi_fatal_exception(env, fatal_exception);
+    if (CallJSFunction(env, func, sizeof...(ArgTypes), args,
+                       &result) == napi_ok) {
+      return result;
     }
     return nullptr;
   }
@@ -0,0 +1,159 @@
+// Copyright (c) zcbenz.
+// Licensed under the MIT License.
+
+#ifndef SRC_EXTERNAL_STRING_H_
+#define SRC_EXTERNAL_STRING_H_
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+#include "src/types.h"
+
+namespace ki {
+
+// A string whose data outlives the JS string, like string literals and
+// constant tables, which becomes a JS string without copying:
+//   Set(env, exports, "license", StaticString(kLicenseText));
+// The char data is UTF-8 and only ASCII strings can be external, other strings
+// fall back to copying. External strings are experimental in Node-API and only
+// used when building with NAPI_EXPERIMENTAL.
+class StaticString {
+ public:
+  template<size_t n>
+  constexpr StaticString(const char (&str)[n])  // NOLINT
+      : str_(std::string_view(str, n - 1)) {}
+  template<size_t n>
+  constexpr StaticString(const char16_t (&str)[n])  // NOLINT
+      : str_(std::u16string_view(str, n - 1)) {}
+  constexpr StaticString(const char* str, size_t length)
+      : str_(std::string_view(str, length)) {}
+  constexpr StaticString(const char16_t* str, size_t length)
+      : str_(std::u16string_view(str, length)) {}
+
+  const std::variant<std::string_view, std::u16string_view>& str() const {
+    return str_;
+  }
+
+ private:
+  std::variant<std::string_view, std::u16string_view> str_;
+};
+
+// A string moved to JS without copying, the storage is freed when the JS string
+// is garbage collected. Same with StaticString, only ASCII std::string can be
+// external.
+class ExternalString {
+ public:
+  explicit ExternalString(std::string str) : str_(std::move(str)) {}
+  explicit ExternalString(std::u16string str) : str_(std::move(str)) {}
+
+  std::variant<std::string, std::u16string>& str() { return str_; }
+
+ private:
+  std::variant<std::string, std::u16string> str_;
+};
+
+namespace internal {
+
+#if defined(NODE_API_EXPERIMENTAL_HAS_EXTERNAL_STRINGS)
+// Create external string from |str|, the |finalize| is called when the string
+// is garbage collected or if the string was copied. Returns false if failed
+// and |finalize| is not called.
+template<typename T>
+bool CreateExternalString(napi_env env, T* str, size_t length,
+                          void (*finalize)(FinalizerEnv, void*, void*),
+                          void* hint, napi_value* result) {
+  bool copied = false;
+  napi_status s;
+  if constexpr (std::is_same_v<T, char16_t>) {
+    s = node_api_create_external_string_utf16(env, str, length, finalize,
+                                               hint, result, &copied);
+  } else {
+    s = node_api_create_external_string_latin1(env, str, length, finalize,
+                                                hint, result, &copied);
+  }
+  return s == napi_ok;
+}
+#endif
+
+}  // namespace internal
+
+template<>
+struct Type<StaticString> {
+  static constexpr const char* name = "String";
+  static inline napi_status ToNode(napi_env env,
+                                   const StaticString& value,
+                                   napi_value* result) {
+    if (auto* str = std::get_if<std::string_view>(&value.str())) {
+#if defined(NODE_API_EXPERIMENTAL_HAS_EXTERNAL_STRINGS)
+      // The data is static so there is no need to finalize.
+      if (internal::IsAscii(str->data(), str->length()) &&
+          internal::CreateExternalString(env, const_cast<char*>(str->data()),
+                                         str->length(), nullptr, nullptr,
+                                         result)) {
+        return napi_ok;
+      }
+#endif
+      return internal::CreateStringFromUtf8(env, str->data(), str->length(),
+                                            result);
+    }
+    auto& str = std::get<std::u16string_view>(value.str());
+#if defined(NODE_API_EXPERIMENTAL_HAS_EXTERNAL_STRINGS)
+    if (internal::CreateExternalString(env, const_cast<char16_t*>(str.data()),
+                                       str.length(), nullptr, nullptr,
+                                       result)) {
+      return napi_ok;
+    }
+#endif
+    return napi_create_string_utf16(env, str.data(), str.length(), result);
+  }
+};
+
+template<>
+struct Type<ExternalString> {
+  static constexpr const char* name = "String";
+  static inline napi_status ToNode(napi_env env,
+                                   ExternalString value,
+                                   napi_value* result) {
+    if (auto* str = std::get_if<std::string>(&value.str())) {
+#if defined(NODE_API_EXPERIMENTAL_HAS_EXTERNAL_STRINGS)
+      if (internal::IsAscii(str->data(), str->length()) &&
+          CreateExternal(env, str, result)) {
+        return napi_ok;
+      }
+#endif
+      return internal::CreateStringFromUtf8(env, str->data(), str->length(),
+                                            result);
+    }
+    auto& str = std::get<std::u16string>(value.str());
+#if defined(NODE_API_EXPERIMENTAL_HAS_EXTERNAL_STRINGS)
+    if (CreateExternal(env, &str, result))
+      return napi_ok;
+#endif
+    return napi_create_string_utf16(env, str.data(), str.length(), result);
+  }
+
+#if defined(NODE_API_EXPERIMENTAL_HAS_EXTERNAL_STRINGS)
+ private:
+  // Move the string to heap and free it in finalizer.
+  template<typename S>
+  static bool CreateExternal(napi_env env, S* str, napi_value* result) {
+    auto* owner = new S(std::move(*str));
+    bool success = internal::CreateExternalString(
+        env, owner->data(), owner->length(),
+        [](internal::FinalizerEnv, void* data, void* hint) {
+          delete static_cast<S*>(hint);
+        }, owner, result);
+    if (!success) {
+      *str = std::move(*owner);
+      delete owner;
+    }
+    return success;
+  }
+#endif
+};
+
+}  // namespace ki
+
+#endif  // SRC_EXTERNAL_STRING_H_
@@ -4,32 +4,53 @@
 #ifndef SRC_INSTANCE_DATA_H_
 #define SRC_INSTANCE_DATA_H_
 
+#include <atomic>
 #include <map>
 #include <utility>
+#include <vector>
 
 #include "src/map.h"
+#include "src/wrapper_table.h"
 
 namespace ki {
 
 namespace internal {
 
-// Get the base name of a type.
+// Get the top base type of a type.
 template<typename T, typename Enable = void>
 struct TopClass {
-  static constexpr const char* name = Type<std::remove_cv_t<T>>::name;
+  using type = std::remove_cv_t<T>;
 };
 
 template<typename T>
 struct TopClass<T, typename std::enable_if<std::is_class<
                        typename Type<T>::Base>::value>::type> {
-  static constexpr const char* name = TopClass<typename Type<T>::Base>::name;
+  using type = typename TopClass<typename Type<T>::Base>::type;
 };
 
+// Return an unique id for each type.
+template<typename T>
+const void* GetTypeId() {
+  static const char id = 0;
+  return &id;
+}
+
+// Return the next free index of per-type slots.
+inline size_t NextSlotIndex() {
+  static std::atomic<size_t> next_index{0};
+  return next_index++;
+}
+
 }  // namespace internal
 
 class InstanceData {
  public:
   static InstanceData* Get(napi_env env) {
+    // Each env is only used on its own thread, so the last used one is cached
+    // per thread to avoid calling napi_get_instance_data.
+    LastUsed& last_used = GetLastUsed();
+    if (last_used.env == env)
+      return last_used.data;
     void* data = nullptr;
     napi_status s = napi_get_instance_data(env, &data);
     assert(s == napi_ok);
@@ -42,9 +63,12 @@ class InstanceData {
     }
     InstanceData* ret = static_cast<InstanceData*>(data);
     assert(ret->tag_ == 0x8964);
+    last_used = {env, ret};
     return ret;
   }
 
+  napi_env env() const { return env_; }
+
   // Get or create a object attached to an object.
   Map GetOrCreateAttachedTable(napi_value object) {
     Map lookup = attached_tables_.ToLocal<Map>();
@@ -73,37 +97,61 @@ class InstanceData {
     strong_refs_.erase(key);
   }
 
+  // Dense slots of persistent handles indexed by types, the index of each key
+  // type is assigned on first use and shared by all environments:
+  //   size_t index = InstanceData::GetSlotIndex<Key>();
+  template<typename Key>
+  static size_t GetSlotIndex() {
+    static const size_t index = internal::NextSlotIndex();
+    return index;
+  }
+
+  void SetSlot(size_t index, napi_value value) {
+    if (index >= slots_.size())
+      slots_.resize(index + 1);
+    slots_[index] = Persistent(env_, value);
+  }
+
+  bool GetSlot(size_t index, napi_value* out) const {
+    if (index >= slots_.size() || slots_[index].IsEmpty())
+      return false;
+    *out = slots_[index].Value();
+    return true;
+  }
+
   // In C++ the address of a class's first member data is equivalent to the
   // address of the class itself, so 1 pointer can actually represent 2
   // different instances. To avoid duplicate key for different instances, we
-  // also include typename as part of the key.
-  using WrapperKey = std::pair<const char*, void*>;
+  // also include the type id of the top base class as part of the key.
+  template<typename T>
+  static const void* GetWrapperTypeId() {
+    return internal::GetTypeId<typename internal::TopClass<T>::type>();
+  }
 
   // Used to store the results of napi_wrap, it is caller's responsibility to
   // destroy the result.
   template<typename T>
   void AddWrapper(void* ptr, napi_ref ref) {
-    WrapperKey key{internal::TopClass<T>::name, ptr};
-    wrappers_.emplace(key, Persistent(env_, ref));
+    if (!wrappers_.Add(GetWrapperTypeId<T>(), ptr, ref))
+      napi_delete_reference(env_, ref);
   }
 
   template<typename T>
   bool GetWrapper(void* ptr, napi_value* result) const {
-    WrapperKey key{internal::TopClass<T>::name, ptr};
-    auto it = wrappers_.find(key);
-    if (it == wrappers_.end())
+    napi_ref ref = wrappers_.Get(GetWrapperTypeId<T>(), ptr);
+    if (!ref)
       return false;
-    *result = it->second.Value();
+    *result = nullptr;
+    napi_get_reference_value(env_, ref, result);
     return *result != nullptr;
   }
 
   template<typename T>
   bool DeleteWrapper(void* ptr) {
-    WrapperKey key{internal::TopClass<T>::name, ptr};
-    auto it = wrappers_.find(key);
-    if (it == wrappers_.end())
+    napi_ref ref = wrappers_.Remove(GetWrapperTypeId<T>(), ptr);
+    if (!ref)
       return false;
-    wrappers_.erase(key);
+    napi_delete_reference(env_, ref);
     return true;
   }
 
@@ -116,18 +164,30 @@ class InstanceData {
       : env_(env),
         attached_tables_(env, WeakMap(env)) {}
 
+  // Node frees all references on exit whether they belong to user or runtime,
+  // so the refs of wrappers are leaked to avoid double free.
   ~InstanceData() {
-    // Node frees all references on exit whether they belong to user or runtime,
-    // so we have to leak them to avoid double free.
-    for (auto& [key, handle] : wrappers_) {
-      handle.Release();
-    }
+    // The address of env may be reused by a new env.
+    LastUsed& last_used = GetLastUsed();
+    if (last_used.data == this)
+      last_used = LastUsed();
+  }
+
+  struct LastUsed {
+    napi_env env = nullptr;
+    InstanceData* data = nullptr;
+  };
+
+  static LastUsed& GetLastUsed() {
+    thread_local LastUsed last_used;
+    return last_used;
   }
 
   napi_env env_;
   Persistent attached_tables_;
   std::map<void*, Persistent> strong_refs_;
-  std::map<WrapperKey, Persistent> wrappers_;
+  std::vector<Persistent> slots_;
+  internal::WrapperTable wrappers_;
 
   const int tag_ = 0x8964;
 };
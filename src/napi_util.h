@@ -15,7 +15,8 @@ template<typename T>
 napi_status AddToFinalizer(napi_env env, napi_value object,
                            std::unique_ptr<T> ptr) {
   napi_status s = napi_add_finalizer(env, object, ptr.get(),
-                                     [](napi_env, void* ptr, void*) {
+                                     [](internal::FinalizerEnv,
+                                        void* ptr, void*) {
     delete static_cast<T*>(ptr);
   }, nullptr, nullptr);
   if (s != napi_ok)
@@ -95,6 +96,61 @@ class EscapableHandleScope {
   napi_escapable_handle_scope scope_;
 };
 
+// Create a callback scope for invoking many JS callbacks in a batch, for
+// example when dispatching native events from the event loop. The converted
+// std::functions invoked inside it share the handle scope and callback scope
+// of the batch, and microtasks are run once when the batch is closed.
+class CallbackBatchScope {
+ public:
+  explicit CallbackBatchScope(napi_env env,
+                              const char* name = "CallbackBatchScope")
+      : env_(env), handle_scope_(env), previous_(Current()) {
+    napi_value resource_name;
+    napi_status s = napi_create_string_utf8(env, name, NAPI_AUTO_LENGTH,
+                                            &resource_name);
+    assert(s == napi_ok);
+    napi_value resource = CreateObject(env);
+    s = napi_async_init(env, resource, resource_name, &context_);
+    assert(s == napi_ok);
+    s = napi_open_callback_scope(env, resource, context_, &scope_);
+    assert(s == napi_ok);
+    Current() = this;
+  }
+
+  ~CallbackBatchScope() {
+    Current() = previous_;
+    napi_status s = napi_close_callback_scope(env_, scope_);
+    assert(s == napi_ok);
+    s = napi_async_destroy(env_, context_);
+    assert(s == napi_ok);
+  }
+
+  // Return whether there is a batch scope open for |env|.
+  static bool IsActive(napi_env env) {
+    return Current() && Current()->env_ == env;
+  }
+
+  CallbackBatchScope& operator=(const CallbackBatchScope&) = delete;
+  CallbackBatchScope(const CallbackBatchScope&) = delete;
+
+  void* operator new(size_t) = delete;
+  void* operator new[] (size_t) = delete;
+  void operator delete(void*) = delete;
+  void operator delete[] (void*) = delete;
+
+ private:
+  static CallbackBatchScope*& Current() {
+    static thread_local CallbackBatchScope* current = nullptr;
+    return current;
+  }
+
+  napi_env env_;
+  HandleScope handle_scope_;
+  CallbackBatchScope* previous_;
+  napi_async_context context_;
+  napi_callback_scope scope_;
+};
+
 }  // namespace ki
 
 #endif  // SRC_NAPI_UTIL_H_
@@ -0,0 +1,152 @@
+// Copyright (c) zcbenz.
+// Licensed under the MIT License.
+
+#ifndef SRC_OWNED_BUFFER_H_
+#define SRC_OWNED_BUFFER_H_
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "src/typed_array.h"
+
+namespace ki {
+
+namespace internal {
+
+// Type-erased owner of the memory.
+struct OwnedStorage {
+  virtual ~OwnedStorage() = default;
+};
+
+template<typename C>
+struct OwnedStorageImpl : public OwnedStorage {
+  explicit OwnedStorageImpl(C&& container) : container(std::move(container)) {}
+  C container;
+};
+
+}  // namespace internal
+
+// Memory whose ownership is transferred to JS when converted, without copying:
+//   ki::OwnedBuffer<float> Render() {
+//     return ki::OwnedBuffer<float>(std::move(pixels), size);
+//   }
+// It is converted to Buffer for uint8_t, to TypedArray for other numbers, and
+// to ArrayBuffer otherwise. The memory is freed when the JS object is garbage
+// collected.
+template<typename T>
+class OwnedBuffer {
+ public:
+  static_assert(std::is_trivially_copyable_v<T>,
+                "OwnedBuffer only supports trivially copyable types.");
+
+  OwnedBuffer(std::unique_ptr<T[]> data, size_t size)
+      : data_(data.get()),
+        size_(size),
+        storage_(std::make_unique<
+                     internal::OwnedStorageImpl<std::unique_ptr<T[]>>>(
+                         std::move(data))) {}
+
+  explicit OwnedBuffer(std::vector<T>&& vec)
+      : data_(vec.data()),
+        size_(vec.size()),
+        storage_(std::make_unique<internal::OwnedStorageImpl<std::vector<T>>>(
+                     std::move(vec))) {}
+
+  OwnedBuffer(OwnedBuffer&&) = default;
+  OwnedBuffer& operator=(OwnedBuffer&&) = default;
+
+  T* data() const { return data_; }
+  size_t size() const { return size_; }
+  size_t size_bytes() const { return size_ * sizeof(T); }
+
+ private:
+  T* data_;
+  size_t size_;
+  std::unique_ptr<internal::OwnedStorage> storage_;
+};
+
+// Transfer the memory of the vector to JS when converted.
+template<typename T>
+inline OwnedBuffer<T> Transfer(std::vector<T>&& vec) {
+  return OwnedBuffer<T>(std::move(vec));
+}
+
+template<typename T>
+struct Type<OwnedBuffer<T>> {
+  static constexpr const char* name = std::is_same_v<T, uint8_t> ?
+      "Buffer" : (internal::is_typed_array_element_v<T> ? "TypedArray"
+                                                        : "ArrayBuffer");
+  static napi_status ToNode(napi_env env,
+                            OwnedBuffer<T> value,
+                            napi_value* result) {
+    size_t size = value.size();
+    napi_status s = size > 0 ? CreateExternal(env, &value, result)
+                             : napi_no_external_buffers_allowed;
+    // Runtimes with sandboxed memory do not allow external buffers.
+    if (s == napi_no_external_buffers_allowed)
+      s = CreateCopy(env, value, result);
+    if (s != napi_ok)
+      return s;
+    if constexpr (!std::is_same_v<T, uint8_t> &&
+                  internal::is_typed_array_element_v<T>) {
+      s = napi_create_typedarray(
+          env, static_cast<napi_typedarray_type>(
+                   internal::GetTypedArrayType<T>()),
+          size, *result, 0, result);
+    }
+    return s;
+  }
+
+ private:
+  // Move the buffer into the finalizer of the JS object, and move it back on
+  // failure.
+  static napi_status CreateExternal(napi_env env, OwnedBuffer<T>* value,
+                                    napi_value* result) {
+    auto owner = std::make_unique<OwnedBuffer<T>>(std::move(*value));
+    napi_status s;
+    if constexpr (std::is_same_v<T, uint8_t>) {
+      s = napi_create_external_buffer(env, owner->size_bytes(), owner->data(),
+                                      &Finalize, owner.get(), result);
+    } else {
+      s = napi_create_external_arraybuffer(env, owner->data(),
+                                           owner->size_bytes(), &Finalize,
+                                           owner.get(), result);
+    }
+    if (s != napi_ok) {
+      *value = std::move(*owner);
+      return s;
+    }
+    // Let GC know the memory held by the JS object.
+    int64_t adjusted;
+    napi_adjust_external_memory(env, owner->size_bytes(), &adjusted);
+    owner.release();
+    return napi_ok;
+  }
+
+  static napi_status CreateCopy(napi_env env, const OwnedBuffer<T>& value,
+                                napi_value* result) {
+    if constexpr (std::is_same_v<T, uint8_t>) {
+      return napi_create_buffer_copy(env, value.size_bytes(), value.data(),
+                                     nullptr, result);
+    } else {
+      void* data;
+      napi_status s = napi_create_arraybuffer(env, value.size_bytes(), &data,
+                                              result);
+      if (s == napi_ok && value.size() > 0)
+        std::memcpy(data, value.data(), value.size_bytes());
+      return s;
+    }
+  }
+
+  static void Finalize(internal::FinalizerEnv env, void*, void* hint) {
+    std::unique_ptr<OwnedBuffer<T>> owner(static_cast<OwnedBuffer<T>*>(hint));
+    int64_t adjusted;
+    napi_adjust_external_memory(
+        env, -static_cast<int64_t>(owner->size_bytes()), &adjusted);
+  }
+};
+
+}  // namespace ki
+
+#endif  // SRC_OWNED_BUFFER_H_
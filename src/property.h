@@ -5,6 +5,7 @@
 #define SRC_PROPERTY_H_
 
 #include "src/attached_table.h"
+#include "src/callback.h"
 #include "src/property_internal.h"
 
 namespace ki {
@@ -20,6 +21,12 @@ inline auto Getter(MemberFunctionHolder<T> func) {
   return Getter(func.func, HolderIsFirstArgument);
 }
 
+template<auto func, int flags>
+inline auto Getter(Fn<func, flags>) {
+  return internal::StaticPropertyMethod<internal::CallbackType::Getter>{
+      &internal::StaticCallback<func, flags>::Invoke};
+}
+
 template<typename T>
 inline auto Setter(T func, int flags = 0) {
   return internal::PropertyMethodHolderFactory<
@@ -31,6 +38,12 @@ inline auto Setter(MemberFunctionHolder<T> func) {
   return Setter(func.func, HolderIsFirstArgument);
 }
 
+template<auto func, int flags>
+inline auto Setter(Fn<func, flags>) {
+  return internal::StaticPropertyMethod<internal::CallbackType::Setter>{
+      &internal::StaticCallback<func, flags>::Invoke};
+}
+
 // Defines a JS property with native methods.
 struct Property {
   using Type = internal::CallbackType;
@@ -70,6 +83,10 @@ struct Property {
   std::string name;
   std::function<internal::NodeCallbackSig> getter;
   std::function<internal::NodeCallbackSig> setter;
+  // The getter and setter bound at compile time, which can be used as the
+  // napi_callback directly.
+  napi_callback static_getter = nullptr;
+  napi_callback static_setter = nullptr;
   napi_value value = nullptr;
   CacheMode cache_mode = CacheMode::NoCache;
 
@@ -102,14 +119,28 @@ struct Property {
     SetProperty(Getter(ptr), Setter(ptr));
   }
 
-  template<typename Sig>
-  void SetProperty(internal::PropertyMethodHolder<Sig, Type::Getter>&& holder) {
+  template<typename Sig, typename Functor>
+  void SetProperty(
+      internal::PropertyMethodHolder<Sig, Type::Getter, Functor>&& holder) {
     getter = CreateNodeCallbackWithHolder(std::move(holder));
+    static_getter = nullptr;
   }
 
-  template<typename Sig>
-  void SetProperty(internal::PropertyMethodHolder<Sig, Type::Setter>&& holder) {
+  template<typename Sig, typename Functor>
+  void SetProperty(
+      internal::PropertyMethodHolder<Sig, Type::Setter, Functor>&& holder) {
     setter = CreateNodeCallbackWithHolder(std::move(holder));
+    static_setter = nullptr;
+  }
+
+  void SetProperty(internal::StaticPropertyMethod<Type::Getter> method) {
+    getter = method.callback;
+    static_getter = method.callback;
+  }
+
+  void SetProperty(internal::StaticPropertyMethod<Type::Setter> method) {
+    setter = method.callback;
+    static_setter = method.callback;
   }
 
   template<typename T, typename... ArgTypes>
@@ -124,7 +155,8 @@ namespace internal {
 // Invoke a property method.
 template<CallbackType type>
 napi_value InvokePropertyMethod(napi_env env, napi_callback_info info) {
-  Arguments args(env, info);
+  // Getters receive no argument and setters receive only one.
+  FixedArguments<1> args(env, info);
   Property* property = static_cast<Property*>(args.Data());
   napi_value result;
   if (type == CallbackType::Getter) {
@@ -157,6 +189,15 @@ inline napi_property_descriptor PropertyToDescriptor(
   descriptor.name = ToNodeValue(env, prop.name);
   descriptor.attributes = prop.attributes;
   descriptor.value = prop.value;
+  // When methods are bound at compile time and there is no cache, they can be
+  // used as the napi_callback directly and no holder is needed.
+  if (prop.cache_mode == Property::CacheMode::NoCache &&
+      (!prop.getter || prop.static_getter) &&
+      (!prop.setter || prop.static_setter)) {
+    descriptor.getter = prop.static_getter;
+    descriptor.setter = prop.static_setter;
+    return descriptor;
+  }
   if (prop.getter)
     descriptor.getter = InvokePropertyMethod<CallbackType::Getter>;
   if (prop.setter)
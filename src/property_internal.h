@@ -17,17 +17,55 @@ enum class CallbackType {
 };
 
 // Extends CallbackHolder with information about callback type.
-template<typename Sig, CallbackType type>
-struct PropertyMethodHolder : public CallbackHolder<Sig> {
-  explicit PropertyMethodHolder(CallbackHolder<Sig>&& holder)
-      : CallbackHolder<Sig>(std::move(holder)) {}
+template<typename Sig, CallbackType type, typename Functor = std::function<Sig>>
+struct PropertyMethodHolder : public CallbackHolder<Sig, Functor> {
+  explicit PropertyMethodHolder(CallbackHolder<Sig, Functor>&& holder)
+      : CallbackHolder<Sig, Functor>(std::move(holder)) {}
+};
+
+// Extract the functor type of CallbackHolder.
+template<typename HolderT>
+struct HolderFunctor;
+
+template<typename Sig, typename Functor>
+struct HolderFunctor<CallbackHolder<Sig, Functor>> {
+  using Type = Functor;
+};
+
+// Functors for reading and writing member object pointers.
+template<typename T>
+struct MemberObjectGetter {
+  using ClassType = typename ExtractMemberPointer<T>::ClassType;
+  using MemberType = typename ExtractMemberPointer<T>::MemberType;
+  MemberType operator()(ClassType* p) const {
+    return p->*member_ptr;
+  }
+  T member_ptr;
+};
+
+template<typename T>
+struct MemberObjectSetter {
+  using ClassType = typename ExtractMemberPointer<T>::ClassType;
+  using MemberType = typename ExtractMemberPointer<T>::MemberType;
+  void operator()(ClassType* p, MemberType m) const {
+    p->*member_ptr = std::move(m);
+  }
+  T member_ptr;
+};
+
+// A property method bound at compile time.
+template<CallbackType type>
+struct StaticPropertyMethod {
+  napi_callback callback;
 };
 
 // Extends CallbackHolderFactory to support member object pointers.
 template<typename T, CallbackType type, typename Enable = void>
 struct PropertyMethodHolderFactory {
   using RunType = typename CallbackHolderFactory<T>::RunType;
-  using HolderT = PropertyMethodHolder<RunType, type>;
+  using HolderT = PropertyMethodHolder<
+      RunType, type,
+      typename HolderFunctor<typename CallbackHolderFactory<T>::HolderT>::Type>;
   static inline HolderT Create(T func, int flags) {
     return HolderT(CallbackHolderFactory<T>::Create(std::move(func), flags));
   }
@@ -41,13 +79,11 @@ struct PropertyMethodHolderFactory<T, CallbackType::Getter,
   using ClassType = typename ExtractMemberPointer<T>::ClassType;
   using MemberType = typename ExtractMemberPointer<T>::MemberType;
   using RunType = MemberType(ClassType*);
-  using HolderT = PropertyMethodHolder<RunType, CallbackType::Getter>;
+  using HolderT = PropertyMethodHolder<RunType, CallbackType::Getter,
+                                       MemberObjectGetter<T>>;
   static inline HolderT Create(T member_ptr, int flags) {
-    std::function<RunType> func = [member_ptr](ClassType* p) {
-      return p->*member_ptr;
-    };
-    return HolderT(CallbackHolderFactory<decltype(func)>::Create(
-        std::move(func), HolderIsFirstArgument | flags));
+    return HolderT(CallbackHolder<RunType, MemberObjectGetter<T>>(
+        MemberObjectGetter<T>{member_ptr}, HolderIsFirstArgument | flags));
   }
 };
 
@@ -59,13 +95,11 @@ struct PropertyMethodHolderFactory<T, CallbackType::Setter,
   using ClassType = typename ExtractMemberPointer<T>::ClassType;
   using MemberType = typename ExtractMemberPointer<T>::MemberType;
   using RunType = void(ClassType*, MemberType);
-  using HolderT = PropertyMethodHolder<RunType, CallbackType::Setter>;
+  using HolderT = PropertyMethodHolder<RunType, CallbackType::Setter,
+                                       MemberObjectSetter<T>>;
   static inline HolderT Create(T member_ptr, int flags) {
-    std::function<RunType> func = [member_ptr](ClassType* p, MemberType m) {
-      p->*member_ptr = std::move(m);
-    };
-    return HolderT(CallbackHolderFactory<decltype(func)>::Create(
-        std::move(func), HolderIsFirstArgument | flags));
+    return HolderT(CallbackHolder<RunType, MemberObjectSetter<T>>(
+        MemberObjectSetter<T>{member_ptr}, HolderIsFirstArgument | flags));
   }
 };
 
@@ -25,37 +25,58 @@ struct Type<Class<T>> {
   }
 };
 
+namespace internal {
+
+// Called when the JS object created by ManagePointerInJSWrapper is collected.
+template<typename T, bool stored_inline>
+void FinalizeManagedPointer(FinalizerEnv env, void* data, void* ptr) {
+  DeleteWrapper(FromFinalizerEnv(env), static_cast<T*>(ptr), stored_inline);
+  FinalizeWrapData<T>(static_cast<WrapData*>(data));
+}
+
+}  // namespace internal
+
 // Helper to create a new class wrapping raw ptr.
 // The Constructor/Destructor of Type<T> will NOT be called.
 template<typename T>
-napi_status ManagePointerInJSWrapper(napi_env env, T* ptr, napi_value* result) {
-  InstanceData* instance_data = InstanceData::Get(env);
+napi_status ManagePointerInJSWrapper(InstanceData* instance_data, T* ptr,
+                                     napi_value* result) {
+  napi_env env = instance_data->env();
   // Check if there is already a JS object created.
-  if (instance_data->GetWrapper<T>(ptr, result))
+  if (internal::GetWrapper(instance_data, ptr, result))
     return napi_ok;
   // Create a JS object with "new Class(external)".
-  napi_value object = internal::CreateInstance<T>(env);
+  napi_value object = internal::CreateInstance<T>(instance_data);
   if (!object)
     return napi_generic_failure;
   // Wrap the |ptr| into JS object.
-  auto* data = internal::Wrap<T>::Do(ptr);
-  using DataType = decltype(data);
+  internal::WrapData* data = internal::CreateWrapData(ptr);
+  const bool store_inline = internal::ClaimInlineWrapper(instance_data, ptr);
   napi_ref ref;
-  napi_status s = napi_wrap(env, object, data,
-                            [](napi_env env, void* data, void* ptr) {
-    InstanceData::Get(env)->DeleteWrapper<T>(ptr);
-    internal::Finalize<T>::Do(static_cast<DataType>(data));
-  }, ptr, &ref);
+  napi_status s = internal::TagObject(env, object);
+  if (s == napi_ok) {
+    s = napi_wrap(env, object, data,
+                  store_inline ? &internal::FinalizeManagedPointer<T, true>
+                               : &internal::FinalizeManagedPointer<T, false>,
+                  ptr, &ref);
+  }
   if (s != napi_ok) {
-    internal::Finalize<T>::Do(data);
+    if (store_inline)
+      internal::ReleaseInlineWrapper(ptr);
+    internal::FinalizeWrapData<T>(data);
     return s;
   }
   // Save wrapper.
-  instance_data->AddWrapper<T>(ptr, ref);
+  internal::AddWrapper(instance_data, ptr, ref, store_inline);
   *result = object;
   return napi_ok;
 }
 
+template<typename T>
+napi_status ManagePointerInJSWrapper(napi_env env, T* ptr, napi_value* result) {
+  return ManagePointerInJSWrapper(InstanceData::Get(env), ptr, result);
+}
+
 // Check if a Type<T> is defined.
 template<typename T, typename Enable = void>
 struct HasKiType : std::false_type {};
@@ -93,9 +114,10 @@ struct Type<T*, std::enable_if_t<!std::is_const_v<T> && HasKiType<T>::value>> {
     void* result;
     if (napi_unwrap(env, value, &result) != napi_ok)
       return internal::AllocateFromNode<T>::Do(env, value);
-    if (!internal::IsInstanceOf<T>(env, value))
+    if (!internal::IsInstanceOf<T>(env, value, result))
       return std::nullopt;
-    T* ptr = internal::Unwrap<T>::Do(result);
+    T* ptr = internal::Unwrap<T>::Do(
+        static_cast<internal::WrapData*>(result)->data);
     if (!ptr)
       return std::nullopt;
     return ptr;
@@ -4,8 +4,11 @@
 #ifndef SRC_PROTOTYPE_INTERNAL_H_
 #define SRC_PROTOTYPE_INTERNAL_H_
 
+#include <array>
+
 #include "src/property.h"
 #include "src/instance_data.h"
+#include "src/wrappable.h"
 
 namespace ki {
 
@@ -39,7 +42,7 @@ inline bool IsCalledFromConverter(const Arguments& args) {
 
 // The default constructor.
 inline napi_value DummyConstructor(napi_env env, napi_callback_info info) {
-  if (!IsCalledFromConverter(Arguments(env, info)))
+  if (!IsCalledFromConverter(FixedArguments<1>(env, info)))
     ThrowError(env, "There is no constructor defined.");
   return nullptr;
 }
@@ -202,12 +205,94 @@ struct Prototype<T, typename std::enable_if<is_function_pointer<
   }
 };
 
+// Check if type has a base type.
+template<typename T, typename = void>
+struct HasBase : std::false_type {};
+
+template<typename T>
+struct HasBase<T, std::enable_if_t<std::is_class_v<typename Type<T>::Base>>>
+    : std::true_type {};
+
+// Number of ancestors of T.
+template<typename T, typename = void>
+struct InheritanceDepth : std::integral_constant<size_t, 0> {};
+
+template<typename T>
+struct InheritanceDepth<T, std::enable_if_t<HasBase<T>::value>>
+    : std::integral_constant<
+          size_t, 1 + InheritanceDepth<typename Type<T>::Base>::value> {};
+
+// The ids of T and its ancestors, indexed by their inheritance depths.
+template<typename T, size_t n>
+void FillTypeChain(std::array<const void*, n>* ids) {
+  (*ids)[InheritanceDepth<T>::value] = GetTypeId<T>();
+  if constexpr (HasBase<T>::value)
+    FillTypeChain<typename Type<T>::Base>(ids);
+}
+
+struct TypeChain {
+  const void* const* ids;
+  size_t depth;
+};
+
+template<typename T>
+const TypeChain* GetTypeChain() {
+  static const auto ids = [] {
+    std::array<const void*, InheritanceDepth<T>::value + 1> ids;
+    FillTypeChain<T>(&ids);
+    return ids;
+  }();
+  static const TypeChain chain = {ids.data(), InheritanceDepth<T>::value};
+  return &chain;
+}
+
+// The data passed to napi_wrap, which keeps the type chain of the wrapped
+// object, so checking whether an object wraps T or types inheriting from T
+// only requires reading the id at T's depth of the chain.
+struct WrapData {
+  void* data;
+  const TypeChain* type;
+};
+
+template<typename T>
+WrapData* CreateWrapData(T* ptr) {
+  return new WrapData{Wrap<T>::Do(ptr), GetTypeChain<T>()};
+}
+
+template<typename T>
+void FinalizeWrapData(WrapData* data) {
+  using DataType = decltype(Wrap<T>::Do(nullptr));
+  Finalize<T>::Do(static_cast<DataType>(data->data));
+  delete data;
+}
+
+#if NAPI_VERSION >= 8
+// All objects wrapped by this module are tagged with the same tag, so the
+// results of napi_unwrap are known to be WrapData after checking the tag.
+inline const napi_type_tag* GetWrapTag() {
+  // The address of the tag is unique for each module.
+  static const napi_type_tag tag = {reinterpret_cast<uintptr_t>(&tag),
+                                    0x6b697a756e617069};
+  return &tag;
+}
+#endif
+
+// Tag the JS |object| that wraps native object.
+inline napi_status TagObject(napi_env env, napi_value object) {
+#if NAPI_VERSION >= 8
+  return napi_type_tag_object(env, object, GetWrapTag());
+#else
+  return napi_ok;
+#endif
+}
+
 template<typename, typename = void>
 struct InheritanceChain;
 
 // Create a new JS object with T's prorotype chain.
 template<typename T>
-inline napi_value CreateInstance(napi_env env) {
+inline napi_value CreateInstance(InstanceData* instance_data) {
+  napi_env env = instance_data->env();
   // Pass an External to indicate it is called from native code.
   napi_value external;
   napi_status s = napi_create_external(env, GetConstructorKey(),
@@ -215,7 +300,7 @@ inline napi_value CreateInstance(napi_env env) {
   if (s != napi_ok)
     return nullptr;
   // Create a JS object with "new Class(external)".
-  napi_value constructor = InheritanceChain<T>::Get(env);
+  napi_value constructor = InheritanceChain<T>::Get(instance_data);
   napi_value object;
   s = napi_new_instance(env, constructor, 1, &external, &object);
   if (s != napi_ok)
@@ -223,6 +308,11 @@ inline napi_value CreateInstance(napi_env env) {
   return object;
 }
 
+template<typename T>
+inline napi_value CreateInstance(napi_env env) {
+  return CreateInstance<T>(InstanceData::Get(env));
+}
+
 // Define T's constructor according to its type traits.
 template<typename T, typename Enable = void>
 struct DefineClass {
@@ -247,28 +337,24 @@ template<typename T>
 struct DefineClass<T, typename std::enable_if<is_function_pointer<
                            decltype(&Type<T>::Constructor)>::value>::type> {
   using Sig = typename FunctorTraits<decltype(&Type<T>::Constructor)>::RunType;
-  using HolderT = CallbackHolder<Sig>;
   static napi_status Do(napi_env env, napi_value* result) {
     static_assert(HasFinalize<T>::value || HasDestructor<T>::value,
                   "A type that has Type<T>::Constructor defined must also have "
                   "Type<T>::Destructor or TypeBridge<T>::Finalize defined.");
-    auto holder = std::make_unique<HolderT>(&Type<T>::Constructor);
     napi_value constructor;
     napi_status s = napi_define_class(env, Type<T>::name, NAPI_AUTO_LENGTH,
-                                      &DispatchToCallback, holder.get(),
+                                      &DispatchToCallback, nullptr,
                                       0, nullptr, &constructor);
     if (s != napi_ok)
       return s;
     if (!Prototype<T>::Define(env, constructor))
       return napi_generic_failure;
-    s = AddToFinalizer(env, constructor, std::move(holder));
-    if (s != napi_ok)
-      return s;
     *result = constructor;
     return napi_ok;
   }
   static napi_value DispatchToCallback(napi_env env, napi_callback_info info) {
-    Arguments args(env, info);
+    // Reserve at least 1 argument for checking IsCalledFromConverter.
+    typename CallbackArguments<Sig, 1>::Type args(env, info);
     // Only allow constructor call like "new Class()" by default.
     const bool is_constructor_call = args.IsConstructorCall();
     if (!AllowFunctionCall<T>::value && !is_constructor_call) {
@@ -279,55 +365,72 @@ struct DefineClass<T, typename std::enable_if<is_function_pointer<
     if (IsCalledFromConverter(args))
       return nullptr;
     // Invoke native constructor.
-    std::optional<T*> ptr = CallbackInvoker<Sig>::Invoke(&args);
+    std::optional<T*> ptr = CallbackInvoker<Sig>::InvokeCallable(
+        &args, &Type<T>::Constructor, 0);
     if (!ptr || !ptr.value()) {
       ThrowError(env, "Unable to invoke constructor.");
       return nullptr;
     }
+    InstanceData* instance_data = InstanceData::Get(env);
     // By default we wrap on the |this| object, unless this is a function call.
     napi_value object = is_constructor_call ? args.This()
-                                            : CreateInstance<T>(env);
+                                            : CreateInstance<T>(instance_data);
     // Then wrap the native pointer.
-    auto* data = Wrap<T>::Do(ptr.value());
-    using DataType = decltype(data);
+    WrapData* data = CreateWrapData(ptr.value());
+    const bool store_inline = ClaimInlineWrapper(instance_data, ptr.value());
     napi_ref ref;
-    napi_status s = napi_wrap(env, object, data,
-                              [](napi_env env, void* data, void* ptr) {
-      InstanceData::Get(env)->DeleteWrapper<T>(ptr);
-      Finalize<T>::Do(static_cast<DataType>(data));
-      Destruct<T>::Do(static_cast<T*>(ptr));
-    }, ptr.value(), &ref);
+    napi_status s = TagObject(env, object);
+    if (s == napi_ok) {
+      s = napi_wrap(env, object, data,
+                    store_inline ? &FinalizeWrapper<true>
+                                 : &FinalizeWrapper<false>,
+                    ptr.value(), &ref);
+    }
     if (s != napi_ok) {
-      Finalize<T>::Do(data);
+      if (store_inline)
+        ReleaseInlineWrapper(ptr.value());
+      FinalizeWrapData<T>(data);
       Destruct<T>::Do(ptr.value());
       ThrowError(env, "Unable to wrap native object.");
+      return nullptr;
     }
     // Save wrapper.
-    InstanceData::Get(env)->AddWrapper<T>(ptr.value(), ref);
+    AddWrapper(instance_data, ptr.value(), ref, store_inline);
     // For constructor call we should never return an object.
     if (is_constructor_call)
       return nullptr;
     else
       return object;
   }
+  template<bool stored_inline>
+  static void FinalizeWrapper(FinalizerEnv env, void* data, void* ptr) {
+    DeleteWrapper(FromFinalizerEnv(env), static_cast<T*>(ptr), stored_inline);
+    FinalizeWrapData<T>(static_cast<WrapData*>(data));
+    Destruct<T>::Do(static_cast<T*>(ptr));
+  }
 };
 
 // Get bare constructor for T.
 template<typename T>
-bool GetOrCreateConstructor(napi_env env, napi_value* constructor) {
+bool GetOrCreateConstructor(InstanceData* instance_data,
+                            napi_value* constructor) {
   // Get cached constructor.
-  static int key = 0x19980604;
-  InstanceData* instance_data = InstanceData::Get(env);
-  if (instance_data->Get(&key, constructor))
+  const size_t index = InstanceData::GetSlotIndex<DefineClass<T>>();
+  if (instance_data->GetSlot(index, constructor))
     return true;
   // Create a new one if not found.
-  napi_status s = DefineClass<T>::Do(env, constructor);
+  napi_status s = DefineClass<T>::Do(instance_data->env(), constructor);
   assert(s == napi_ok);
   // Cache it forever.
-  instance_data->Set(&key, *constructor);
+  instance_data->SetSlot(index, *constructor);
   return false;
 }
 
+template<typename T>
+bool GetOrCreateConstructor(napi_env env, napi_value* constructor) {
+  return GetOrCreateConstructor<T>(InstanceData::Get(env), constructor);
+}
+
 // Implement inheritance with setPrototypeOf due to lack of native napi.
 inline void Inherit(napi_env env, napi_value child, napi_value parent) {
   napi_value global, object, set_prototype_of, child_proto, parent_proto;
@@ -354,37 +457,54 @@ inline void Inherit(napi_env env, napi_value child, napi_value parent) {
 template<typename T, typename Enable>
 struct InheritanceChain {
   // There is no base type.
-  static napi_value Get(napi_env env) {
+  static napi_value Get(InstanceData* instance_data) {
     napi_value constructor = nullptr;
-    GetOrCreateConstructor<T>(env, &constructor);
+    GetOrCreateConstructor<T>(instance_data, &constructor);
     return constructor;
   }
+  static napi_value Get(napi_env env) {
+    return Get(InstanceData::Get(env));
+  }
 };
 
 template<typename T>
-struct InheritanceChain<T, typename std::enable_if<std::is_class<
-                               typename Type<T>::Base>::value>::type> {
-  static napi_value Get(napi_env env) {
+struct InheritanceChain<T, std::enable_if_t<HasBase<T>::value>> {
+  static napi_value Get(InstanceData* instance_data) {
     napi_value constructor;
-    if (!GetOrCreateConstructor<T>(env, &constructor)) {
+    if (!GetOrCreateConstructor<T>(instance_data, &constructor)) {
       // Inherit from base type's constructor.
-      napi_value parent = InheritanceChain<typename Type<T>::Base>::Get(env);
-      Inherit(env, constructor, parent);
+      napi_value parent =
+          InheritanceChain<typename Type<T>::Base>::Get(instance_data);
+      Inherit(instance_data->env(), constructor, parent);
     }
     return constructor;
   }
+  static napi_value Get(napi_env env) {
+    return Get(InstanceData::Get(env));
+  }
 };
 
-// Return if JS |object| is an instance of |T|.
+// Return if JS |object| is a wrapper of |T| or types inheriting from |T|, the
+// |data| is the result of napi_unwrap.
 template<typename T>
-bool IsInstanceOf(napi_env env, napi_value object) {
+bool IsInstanceOf(napi_env env, napi_value object, void* data) {
+#if NAPI_VERSION >= 8
+  bool result = false;
+  if (napi_check_object_type_tag(env, object, GetWrapTag(), &result) != napi_ok
+      || !result) {
+    return false;
+  }
+#else
   napi_value constructor;
   if (!GetOrCreateConstructor<T>(env, &constructor))
     return false;
   bool result = false;
-  napi_instanceof(env, object, constructor, &result);
-  // TODO(zcbenz): Check native type tag.
-  return result;
+  if (napi_instanceof(env, object, constructor, &result) != napi_ok || !result)
+    return false;
+#endif
+  constexpr size_t depth = InheritanceDepth<T>::value;
+  const TypeChain* type = static_cast<WrapData*>(data)->type;
+  return type->depth >= depth && type->ids[depth] == GetTypeId<T>();
 }
 
 }  // namespace internal
@@ -0,0 +1,146 @@
+// Copyright (c) zcbenz.
+// Licensed under the MIT License.
+
+#ifndef SRC_SPAN_H_
+#define SRC_SPAN_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+#include <span>
+#endif
+
+#include "src/typed_array.h"
+
+namespace ki {
+
+// A view of the memory of TypedArray, Buffer, DataView or ArrayBuffer, which
+// is converted without copying:
+//   double Sum(ki::Span<const double> samples);
+// The memory is owned by the JS object, so the span must not be used after
+// the function returns.
+template<typename T>
+class Span {
+ public:
+  constexpr Span() = default;
+  constexpr Span(T* data, size_t size) : data_(data), size_(size) {}
+
+  constexpr T* data() const { return data_; }
+  constexpr size_t size() const { return size_; }
+  constexpr size_t size_bytes() const { return size_ * sizeof(T); }
+  constexpr bool empty() const { return size_ == 0; }
+
+  constexpr T* begin() const { return data_; }
+  constexpr T* end() const { return data_ + size_; }
+  constexpr T& operator[](size_t i) const { return data_[i]; }
+
+ private:
+  T* data_ = nullptr;
+  size_t size_ = 0;
+};
+
+namespace internal {
+
+// Whether T can be used to read raw bytes of any buffer.
+template<typename T>
+inline constexpr bool is_byte_type_v =
+    std::is_same_v<T, char> ||
+    std::is_same_v<T, unsigned char> ||
+    std::is_same_v<T, std::byte>;
+
+inline size_t GetTypedArrayElementSize(napi_typedarray_type type) {
+  switch (type) {
+    case napi_int8_array:
+    case napi_uint8_array:
+    case napi_uint8_clamped_array:
+      return 1;
+    case napi_int16_array:
+    case napi_uint16_array:
+      return 2;
+    case napi_int32_array:
+    case napi_uint32_array:
+    case napi_float32_array:
+      return 4;
+    default:
+      return 8;
+  }
+}
+
+template<typename T>
+bool IsTypedArrayCompatible(napi_typedarray_type type) {
+  if constexpr (is_byte_type_v<T>)
+    return true;
+  else if constexpr (is_typed_array_element_v<T>)
+    return type == GetTypedArrayType<T>();
+  else
+    return false;
+}
+
+// Get the memory of a TypedArray, DataView or ArrayBuffer.
+template<typename T>
+std::optional<Span<T>> GetSpan(napi_env env, napi_value value) {
+  using E = std::remove_const_t<T>;
+  static_assert(std::is_trivially_copyable_v<E>,
+                "Span only supports trivially copyable types.");
+  void* data = nullptr;
+  size_t byte_length = 0;
+  bool is_type = false;
+  if (napi_is_typedarray(env, value, &is_type) == napi_ok && is_type) {
+    // Node's Buffer is also a Uint8Array.
+    napi_typedarray_type type;
+    size_t length;
+    if (napi_get_typedarray_info(env, value, &type, &length, &data,
+                                 nullptr, nullptr) != napi_ok ||
+        !IsTypedArrayCompatible<E>(type)) {
+      return std::nullopt;
+    }
+    byte_length = length * GetTypedArrayElementSize(type);
+  } else if (napi_is_dataview(env, value, &is_type) == napi_ok && is_type) {
+    if (napi_get_dataview_info(env, value, &byte_length, &data,
+                               nullptr, nullptr) != napi_ok) {
+      return std::nullopt;
+    }
+  } else if (napi_is_arraybuffer(env, value, &is_type) == napi_ok && is_type) {
+    if (napi_get_arraybuffer_info(env, value, &data, &byte_length) != napi_ok)
+      return std::nullopt;
+  } else {
+    return std::nullopt;
+  }
+  if (byte_length % sizeof(E) != 0 ||
+      reinterpret_cast<uintptr_t>(data) % alignof(E) != 0) {
+    return std::nullopt;
+  }
+  return Span<T>(static_cast<T*>(data), byte_length / sizeof(E));
+}
+
+}  // namespace internal
+
+template<typename T>
+struct Type<Span<T>> {
+  static constexpr const char* name = "ArrayBuffer";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_object);
+  static inline std::optional<Span<T>> FromNode(napi_env env,
+                                                napi_value value) {
+    return internal::GetSpan<T>(env, value);
+  }
+};
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+template<typename T>
+struct Type<std::span<T>> {
+  static constexpr const char* name = "ArrayBuffer";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_object);
+  static inline std::optional<std::span<T>> FromNode(napi_env env,
+                                                     napi_value value) {
+    std::optional<Span<T>> span = internal::GetSpan<T>(env, value);
+    if (!span)
+      return std::nullopt;
+    return std::span<T>(span->data(), span->size());
+  }
+};
+#endif
+
+}  // namespace ki
+
+#endif  // SRC_SPAN_H_
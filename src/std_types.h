@@ -4,44 +4,115 @@
 #ifndef SRC_STD_TYPES_H_
 #define SRC_STD_TYPES_H_
 
+#include <iterator>
 #include <set>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <variant>
 #include <vector>
 
 #include "src/iterator.h"
+#include "src/typed_array.h"
 
 namespace ki {
 
+namespace internal {
+
+// Strings shorter than this are decoded with one call into a stack buffer.
+inline constexpr size_t kStringStackBufferSize = 256;
+
+// The UTF-8 encoding stops at character boundaries, so the string might have
+// been truncated if the unused space can not hold the longest character.
+inline bool IsUtf8Complete(size_t copied, size_t buffer_size) {
+  return copied + 4 < buffer_size;
+}
+
+inline bool IsUtf16Complete(size_t copied, size_t buffer_size) {
+  return copied + 1 < buffer_size;
+}
+
+// Decode a long string with two calls, one for length and one for copying.
+template<typename S, typename F>
+std::optional<S> ReadLongString(napi_env env, napi_value value, F read) {
+  size_t length;
+  if (read(env, value, nullptr, 0, &length) != napi_ok)
+    return std::nullopt;
+  S out;
+  if (length > 0) {
+    out.reserve(length + 1);
+    out.resize(length);
+    if (read(env, value, &out.front(), out.capacity(), nullptr) != napi_ok)
+      return std::nullopt;
+  }
+  return out;
+}
+
+// Holds the string for std::string_view arguments during the call, short
+// strings are stored inline without allocation.
+class StringViewHolder {
+ public:
+  static std::optional<StringViewHolder> FromNode(napi_env env,
+                                                  napi_value value) {
+    std::optional<StringViewHolder> result(std::in_place);
+    if (napi_get_value_string_utf8(env, value, result->inline_,
+                                   sizeof(result->inline_),
+                                   &result->length_) != napi_ok) {
+      return std::nullopt;
+    }
+    if (!IsUtf8Complete(result->length_, sizeof(result->inline_))) {
+      auto str = ReadLongString<std::string>(env, value,
+                                             napi_get_value_string_utf8);
+      if (!str)
+        return std::nullopt;
+      result->heap_ = std::move(*str);
+      result->length_ = result->heap_.length();
+      result->on_heap_ = true;
+    }
+    return result;
+  }
+
+  operator std::string_view() const {  // NOLINT
+    return std::string_view(on_heap_ ? heap_.data() : inline_, length_);
+  }
+
+ private:
+  char inline_[kStringStackBufferSize];
+  size_t length_ = 0;
+  bool on_heap_ = false;
+  std::string heap_;
+};
+
+}  // namespace internal
+
 template<>
 struct Type<std::string> {
   static constexpr const char* name = "String";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_string);
   static inline napi_status ToNode(napi_env env,
                                    const std::string& value,
                                    napi_value* result) {
-    return napi_create_string_utf8(env, value.c_str(), value.length(), result);
+    return internal::CreateStringFromUtf8(env, value.c_str(), value.length(),
+                                          result);
   }
   static std::optional<std::string> FromNode(napi_env env, napi_value value) {
+    char buffer[internal::kStringStackBufferSize];
     size_t length;
-    if (napi_get_value_string_utf8(env, value, nullptr, 0, &length) != napi_ok)
+    if (napi_get_value_string_utf8(env, value, buffer, sizeof(buffer),
+                                   &length) != napi_ok) {
       return std::nullopt;
-    std::string out;
-    if (length > 0) {
-      out.reserve(length + 1);
-      out.resize(length);
-      if (napi_get_value_string_utf8(env, value, &out.front(), out.capacity(),
-                                     nullptr) != napi_ok) {
-        return std::nullopt;
-      }
     }
-    return out;
+    if (internal::IsUtf8Complete(length, sizeof(buffer)))
+      return std::string(buffer, length);
+    return internal::ReadLongString<std::string>(env, value,
+                                                 napi_get_value_string_utf8);
   }
 };
 
 template<>
 struct Type<std::u16string> {
   static constexpr const char* name = "String";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_string);
   static inline napi_status ToNode(napi_env env,
                                    const std::u16string& value,
                                    napi_value* result) {
@@ -49,19 +120,40 @@ struct Type<std::u16string> {
   }
   static std::optional<std::u16string> FromNode(napi_env env,
                                                 napi_value value) {
+    char16_t buffer[internal::kStringStackBufferSize / 2];
     size_t length;
-    if (napi_get_value_string_utf16(env, value, nullptr, 0, &length) != napi_ok)
+    if (napi_get_value_string_utf16(env, value, buffer, std::size(buffer),
+                                    &length) != napi_ok) {
       return std::nullopt;
-    std::u16string out;
-    if (length > 0) {
-      out.reserve(length + 1);
-      out.resize(length);
-      if (napi_get_value_string_utf16(env, value, &out.front(), out.capacity(),
-                                      nullptr) != napi_ok) {
-        return std::nullopt;
-      }
     }
-    return out;
+    if (internal::IsUtf16Complete(length, std::size(buffer)))
+      return std::u16string(buffer, length);
+    return internal::ReadLongString<std::u16string>(
+        env, value, napi_get_value_string_utf16);
+  }
+};
+
+// The std::string_view can only be used as arguments, which points to a
+// buffer that lives until the call ends.
+template<>
+struct Type<std::string_view> {
+  static constexpr const char* name = "String";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_string);
+  static inline napi_status ToNode(napi_env env,
+                                   std::string_view value,
+                                   napi_value* result) {
+    return internal::CreateStringFromUtf8(env, value.data(), value.length(),
+                                          result);
+  }
+};
+
+template<>
+struct Type<internal::StringViewHolder> {
+  static constexpr const char* name = "String";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_string);
+  static inline std::optional<internal::StringViewHolder> FromNode(
+      napi_env env, napi_value value) {
+    return internal::StringViewHolder::FromNode(env, value);
   }
 };
 
@@ -82,6 +174,7 @@ napi_status VectorLikeToNode(napi_env env, const T& vec, napi_value* result) {
 template<typename T>
 struct Type<std::vector<T>> {
   static constexpr const char* name = "Array";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_object);
   static inline napi_status ToNode(napi_env env,
                                    const std::vector<T>& vec,
                                    napi_value* result) {
@@ -90,6 +183,11 @@ struct Type<std::vector<T>> {
   static std::optional<std::vector<T>> FromNode(napi_env env,
                                                 napi_value value) {
     std::vector<T> result;
+    // Matching TypedArrays are copied in bulk.
+    if constexpr (internal::is_typed_array_element_v<T>) {
+      if (internal::ReadTypedArray(env, value, &result))
+        return result;
+    }
     if (!IterateArray<T>(env, value,
                          [&](uint32_t i, T value) {
                            result.push_back(std::move(value));
@@ -111,6 +209,7 @@ struct Type<T, std::enable_if_t<  // is set type
                                       T().count(typename T::value_type()))>>> {
   using V = typename T::value_type;
   static constexpr const char* name = "Array";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_object);
   static napi_status ToNode(napi_env env,
                             const T& vec,
                             napi_value* result) {
@@ -148,6 +247,7 @@ struct Type<T, std::enable_if_t<  // is map type
   using K = typename T::key_type;
   using V = typename T::mapped_type;
   static constexpr const char* name = "Object";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_object);
   static napi_status ToNode(napi_env env,
                             const T& dict,
                             napi_value* result) {
@@ -182,6 +282,9 @@ struct Type<T, std::enable_if_t<  // is map type
 template<typename T>
 struct Type<std::optional<T>> {
   static constexpr const char* name = Type<T>::name;
+  static constexpr uint32_t accepted_types =
+      internal::accepted_value_types_v<T> |
+      ValueTypeMask(napi_undefined, napi_null);
   static napi_status ToNode(napi_env env,
                             const std::optional<T>& value,
                             napi_value* result) {
@@ -189,14 +292,33 @@ struct Type<std::optional<T>> {
       return napi_get_undefined(env, result);
     return ConvertToNode(env, *value, result);
   }
+  static napi_status ToNode(napi_env env,
+                            std::optional<T>&& value,
+                            napi_value* result) {
+    if (!value)
+      return napi_get_undefined(env, result);
+    return ConvertToNode(env, std::move(*value), result);
+  }
   static std::optional<std::optional<T>> FromNode(napi_env env,
                                                   napi_value value) {
+    // When T is known to reject undefined and null, try it first so the common
+    // case does not need an extra typeof.
+    if constexpr ((internal::accepted_value_types_v<T> &
+                   ValueTypeMask(napi_undefined, napi_null)) == 0) {
+      std::optional<T> result = FromNodeTo<T>(env, value);
+      if (result)
+        return result;
+    }
     napi_valuetype type;
     if (napi_typeof(env, value, &type) != napi_ok)
       return std::nullopt;
     if (type == napi_undefined || type == napi_null)
       return std::optional<T>();
-    return FromNodeTo<T>(env, value);
+    if constexpr ((internal::accepted_value_types_v<T> &
+                   ValueTypeMask(napi_undefined, napi_null)) == 0)
+      return std::nullopt;
+    else
+      return FromNodeTo<T>(env, value);
   }
 };
 
@@ -205,6 +327,7 @@ struct Type<std::tuple<ArgTypes...>> {
   using V = std::tuple<ArgTypes...>;
 
   static constexpr const char* name = "Tuple";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_object);
   static napi_status ToNode(napi_env env, const V& tup, napi_value* result) {
     constexpr size_t length = sizeof...(ArgTypes);
     napi_value arr;
@@ -268,6 +391,7 @@ template<typename T1, typename T2>
 struct Type<std::pair<T1, T2>> {
   using V = std::pair<T1, T2>;
   static constexpr const char* name = "Pair";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_object);
   static inline napi_status ToNode(napi_env env,
                                    const V& pair,
                                    napi_value* result) {
@@ -287,6 +411,8 @@ struct Type<std::variant<ArgTypes...>> {
   using V = std::variant<ArgTypes...>;
 
   static constexpr const char* name = "Variant";
+  static constexpr uint32_t accepted_types =
+      (internal::accepted_value_types_v<ArgTypes> | ...);
   static napi_status ToNode(napi_env env, const V& var, napi_value* result) {
     napi_status s = napi_generic_failure;
     std::visit([env, result, &s](const auto& arg) {
@@ -295,16 +421,25 @@ struct Type<std::variant<ArgTypes...>> {
     return s;
   }
   static inline std::optional<V> FromNode(napi_env env, napi_value value) {
-    return GetVar(env, value);
+    // Get the type once and only try the alternatives that may accept it.
+    napi_valuetype type;
+    if (napi_typeof(env, value, &type) != napi_ok)
+      return std::nullopt;
+    return GetVar(env, value, ValueTypeMask(type));
   }
 
  private:
   template<std::size_t I = 0>
-  static std::optional<V> GetVar(napi_env env, napi_value value) {
+  static std::optional<V> GetVar(napi_env env, napi_value value,
+                                 uint32_t type) {
     if constexpr (I < std::variant_size_v<V>) {
       using T = std::variant_alternative_t<I, V>;
-      std::optional<T> result = FromNodeTo<T>(env, value);
-      return result ? std::move(*result) : GetVar<I + 1>(env, value);
+      if (internal::accepted_value_types_v<T> & type) {
+        std::optional<T> result = FromNodeTo<T>(env, value);
+        if (result)
+          return std::move(*result);
+      }
+      return GetVar<I + 1>(env, value, type);
     }
     return std::nullopt;
   }
@@ -315,6 +450,8 @@ struct Type<std::variant<ArgTypes...>> {
 template<>
 struct Type<std::monostate> {
   static constexpr const char* name = "undefined";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_undefined,
+                                                         napi_null);
   static napi_status ToNode(napi_env env, std::monostate, napi_value* result) {
     return napi_get_undefined(env, result);
   }
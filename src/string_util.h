@@ -0,0 +1,85 @@
+// Copyright (c) zcbenz.
+// Licensed under the MIT License.
+
+#ifndef SRC_STRING_UTIL_H_
+#define SRC_STRING_UTIL_H_
+
+#include <node_api.h>
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define KI_ASCII_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define KI_ASCII_NEON
+#endif
+
+namespace ki {
+
+namespace internal {
+
+// Return whether all the bytes are ASCII.
+inline bool IsAscii(const char* str, size_t length) {
+  const char* p = str;
+  const char* end = str + length;
+#if defined(__AVX2__)
+  for (; end - p >= 32; p += 32) {
+    __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    if (_mm256_movemask_epi8(chunk) != 0)
+      return false;
+  }
+#elif defined(KI_ASCII_SSE2)
+  for (; end - p >= 16; p += 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    if (_mm_movemask_epi8(chunk) != 0)
+      return false;
+  }
+#elif defined(KI_ASCII_NEON)
+  for (; end - p >= 16; p += 16) {
+    uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+    if (vmaxvq_u8(chunk) >= 0x80)
+      return false;
+  }
+#endif
+  for (; end - p >= 8; p += 8) {
+    uint64_t chunk;
+    std::memcpy(&chunk, p, 8);
+    if ((chunk & 0x8080808080808080ull) != 0)
+      return false;
+  }
+  for (; p < end; ++p) {
+    if (static_cast<unsigned char>(*p) >= 0x80)
+      return false;
+  }
+  return true;
+}
+
+// Create a string from UTF-8, pure ASCII strings are created as Latin-1 so V8
+// can copy them into one-byte strings without decoding.
+inline napi_status CreateStringFromUtf8(napi_env env,
+                                        const char* str,
+                                        size_t length,
+                                        napi_value* result) {
+  if (!str)
+    return napi_create_string_utf8(env, str, length, result);
+  if (length == NAPI_AUTO_LENGTH)
+    length = std::strlen(str);
+  if (IsAscii(str, length))
+    return napi_create_string_latin1(env, str, length, result);
+  return napi_create_string_utf8(env, str, length, result);
+}
+
+}  // namespace internal
+
+}  // namespace ki
+
+#undef KI_ASCII_SSE2
+#undef KI_ASCII_NEON
+
+#endif  // SRC_STRING_UTIL_H_
@@ -0,0 +1,169 @@
+// Copyright (c) zcbenz.
+// Licensed under the MIT License.
+
+#ifndef SRC_STRUCT_H_
+#define SRC_STRUCT_H_
+
+#include <tuple>
+#include <utility>
+
+#include "src/dict.h"
+#include "src/instance_data.h"
+
+namespace ki {
+
+// A member of struct with its property name.
+template<typename T, typename M>
+struct Field {
+  M T::* member;
+  const char* name;
+};
+
+namespace internal {
+
+template<typename T, typename M>
+constexpr Field<T, M> MakeField(M T::* member, const char* name) {
+  return Field<T, M>{member, name};
+}
+
+template<typename Tuple, size_t... indices>
+constexpr auto MakeFields(const Tuple& args,
+                          std::index_sequence<indices...>) {
+  return std::make_tuple(MakeField(std::get<2 * indices>(args),
+                                   std::get<2 * indices + 1>(args))...);
+}
+
+}  // namespace internal
+
+// Create the field list of a struct from pairs of member and name.
+template<typename... ArgTypes>
+constexpr auto Fields(ArgTypes... args) {
+  static_assert(sizeof...(ArgTypes) % 2 == 0,
+                "Fields must be passed in pairs of member and name.");
+  return internal::MakeFields(
+      std::make_tuple(args...),
+      std::make_index_sequence<sizeof...(ArgTypes) / 2>());
+}
+
+// Convert structs from and to JS objects with a declarative field list:
+//   template<>
+//   struct Type<Point> : Struct<Point> {
+//     static constexpr const char* name = "Point";
+//     static constexpr auto fields = Fields(&Point::x, "x", &Point::y, "y");
+//   };
+// The property keys are created once per environment, and the properties are
+// always added in the order of fields with one call. When converting from JS,
+// the missing and undefined properties keep the default values of T.
+template<typename T>
+struct Struct {
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_object,
+                                                           napi_function);
+
+  static napi_status ToNode(napi_env env, const T& value, napi_value* result) {
+    return ToNodeImpl(env, value, result, Indices());
+  }
+
+  static std::optional<T> FromNode(napi_env env, napi_value value) {
+    if (!internal::IsObject(env, value))
+      return std::nullopt;
+    T result;
+    if (!FromNodeImpl(env, value, &result, Indices()))
+      return std::nullopt;
+    return result;
+  }
+
+ private:
+  // Type<T> is incomplete when Struct<T> is instantiated, so these can not be
+  // static members.
+  static constexpr size_t FieldsCount() {
+    return std::tuple_size_v<std::decay_t<decltype(Type<T>::fields)>>;
+  }
+
+  static constexpr auto Indices() {
+    return std::make_index_sequence<FieldsCount()>();
+  }
+
+  // Return an Array of the property keys, which is created once per
+  // environment. The keys are stored in an Array since references can not be
+  // created for strings.
+  static napi_value GetKeys(napi_env env) {
+    const size_t index = InstanceData::GetSlotIndex<Struct<T>>();
+    InstanceData* instance_data = InstanceData::Get(env);
+    napi_value keys;
+    if (instance_data->GetSlot(index, &keys))
+      return keys;
+    if (napi_create_array_with_length(env, FieldsCount(), &keys) != napi_ok)
+      return nullptr;
+    uint32_t i = 0;
+    std::apply([&](const auto&... field) {
+      (napi_set_element(env, keys, i++, ToNodeValue(env, field.name)), ...);
+    }, Type<T>::fields);
+    instance_data->SetSlot(index, keys);
+    return keys;
+  }
+
+  static napi_value GetKey(napi_env env, napi_value keys, uint32_t i) {
+    napi_value key = nullptr;
+    napi_get_element(env, keys, i, &key);
+    return key;
+  }
+
+  template<size_t... indices>
+  static napi_status ToNodeImpl(napi_env env, const T& value,
+                                napi_value* result,
+                                std::index_sequence<indices...>) {
+    napi_status s = napi_create_object(env, result);
+    if constexpr (FieldsCount() == 0) {
+      return s;
+    } else {
+      if (s != napi_ok)
+        return s;
+      napi_value keys = GetKeys(env);
+      if (!keys)
+        return napi_generic_failure;
+      constexpr auto attributes = static_cast<napi_property_attributes>(
+          napi_writable | napi_enumerable | napi_configurable);
+      // Define all properties in one call.
+      napi_property_descriptor descriptors[] = {
+        {nullptr, GetKey(env, keys, indices), nullptr, nullptr, nullptr,
+         ToNodeValue(env, value.*std::get<indices>(Type<T>::fields).member),
+         attributes, nullptr}...
+      };
+      return napi_define_properties(env, *result, FieldsCount(), descriptors);
+    }
+  }
+
+  template<size_t... indices>
+  static bool FromNodeImpl(napi_env env, napi_value object, T* result,
+                           std::index_sequence<indices...>) {
+    if constexpr (FieldsCount() == 0) {
+      return true;
+    } else {
+      napi_value keys = GetKeys(env);
+      if (!keys)
+        return false;
+      return (ReadField(env, object, GetKey(env, keys, indices),
+                        &(result->*std::get<indices>(Type<T>::fields).member))
+              && ...);
+    }
+  }
+
+  template<typename M>
+  static bool ReadField(napi_env env, napi_value object, napi_value key,
+                        M* out) {
+    napi_value value;
+    if (napi_get_property(env, object, key, &value) != napi_ok)
+      return false;
+    if (IsType(env, value, napi_undefined))
+      return true;
+    std::optional<M> result = FromNodeTo<M>(env, value);
+    if (!result)
+      return false;
+    *out = std::move(*result);
+    return true;
+  }
+};
+
+}  // namespace ki
+
+#endif  // SRC_STRUCT_H_
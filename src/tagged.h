@@ -0,0 +1,199 @@
+// Copyright (c) zcbenz.
+// Licensed under the MIT License.
+
+#ifndef SRC_TAGGED_H_
+#define SRC_TAGGED_H_
+
+#include <algorithm>
+#include <array>
+#include <variant>
+
+#include "src/std_types.h"
+
+namespace ki {
+
+namespace internal {
+
+template<typename T, typename Enable = void>
+struct HasTag : std::false_type {};
+
+template<typename T>
+struct HasTag<T, std::void_t<decltype(Type<T>::tag)>> : std::true_type {};
+
+// The tag of an alternative is Type<T>::tag, or Type<T>::name if not defined.
+template<typename T>
+constexpr const char* GetTag() {
+  if constexpr (HasTag<T>::value)
+    return Type<T>::tag;
+  else
+    return Type<T>::name;
+}
+
+constexpr size_t TagLength(const char* str) {
+  size_t length = 0;
+  while (str[length])
+    ++length;
+  return length;
+}
+
+// FNV-1a hash.
+constexpr uint32_t HashTag(const char* str, size_t length) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < length; ++i) {
+    hash ^= static_cast<uint8_t>(str[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+constexpr bool TagEquals(const char* tag, const char* str, size_t length) {
+  for (size_t i = 0; i < length; ++i) {
+    if (tag[i] != str[i])
+      return false;
+  }
+  return tag[length] == '\0';
+}
+
+// Whether the hashes are distinct after taking modulo of |table_size|, or
+// distinct themselves if |table_size| is 0.
+template<size_t n>
+constexpr bool HasDistinctHashes(const uint32_t (&hashes)[n],
+                                 size_t table_size) {
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = i + 1; j < n; ++j) {
+      if (table_size == 0 ? hashes[i] == hashes[j]
+                          : hashes[i] % table_size == hashes[j] % table_size)
+        return false;
+    }
+  }
+  return true;
+}
+
+// Find the smallest table size that has no collisions, 0 if not found.
+template<size_t n>
+constexpr size_t FindTableSize(const uint32_t (&hashes)[n]) {
+  for (size_t size = n; size <= n * 64; ++size) {
+    if (HasDistinctHashes(hashes, size))
+      return size;
+  }
+  return 0;
+}
+
+// The slot holds index + 1 of the alternative, 0 for empty slot.
+template<size_t table_size, size_t n>
+constexpr std::array<uint8_t, table_size> MakeTagSlots(
+    const uint32_t (&hashes)[n]) {
+  std::array<uint8_t, table_size> slots = {};
+  for (size_t i = 0; i < n; ++i)
+    slots[hashes[i] % table_size] = static_cast<uint8_t>(i + 1);
+  return slots;
+}
+
+// A perfect hash table mapping the tags to the indices of alternatives, which
+// is computed at compile time.
+template<typename... Alts>
+struct TagTable {
+  static constexpr const char* kTags[] = {GetTag<Alts>()...};
+  static constexpr size_t kMaxTagLength =
+      std::max({TagLength(GetTag<Alts>())...});
+  static constexpr uint32_t kHashes[] = {
+      HashTag(GetTag<Alts>(), TagLength(GetTag<Alts>()))...};
+  static_assert(HasDistinctHashes(kHashes, 0),
+                "The tags of alternatives must differ.");
+  static constexpr size_t kTableSize = FindTableSize(kHashes);
+  static_assert(kTableSize > 0, "Can not find a perfect hash for the tags.");
+  static constexpr std::array<uint8_t, kTableSize> kSlots =
+      MakeTagSlots<kTableSize>(kHashes);
+
+  // Return the index of alternative for |str|, or -1 if no match.
+  static int Find(const char* str, size_t length) {
+    uint8_t slot = kSlots[HashTag(str, length) % kTableSize];
+    if (slot == 0 || !TagEquals(kTags[slot - 1], str, length))
+      return -1;
+    return slot - 1;
+  }
+};
+
+}  // namespace internal
+
+// A variant of objects discriminated by the |key| property:
+//   constexpr char kKind[] = "kind";
+//   using Shape = ki::Tagged<kKind, Circle, Rect>;
+// The tag of each alternative is Type<T>::tag, or Type<T>::name if not
+// defined. When converting from JS, the tag is read once and only the matching
+// alternative is converted, and the tag is added to the object when converting
+// to JS.
+template<const char* key, typename... Alts>
+class Tagged : public std::variant<Alts...> {
+ public:
+  static_assert(sizeof...(Alts) > 0 && sizeof...(Alts) < 256,
+                "Tagged must have between 1 and 255 alternatives.");
+
+  using std::variant<Alts...>::variant;
+  using std::variant<Alts...>::operator=;
+
+  const std::variant<Alts...>& variant() const { return *this; }
+};
+
+template<const char* key, typename... Alts>
+struct Type<Tagged<key, Alts...>> {
+  using V = Tagged<key, Alts...>;
+  using Table = internal::TagTable<Alts...>;
+
+  static constexpr const char* name = "Object";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_object,
+                                                           napi_function);
+
+  static napi_status ToNode(napi_env env, const V& value, napi_value* result) {
+    napi_status s = napi_generic_failure;
+    std::visit([env, result, &s](const auto& arg) {
+      s = ConvertToNode(env, arg, result);
+      if (s != napi_ok)
+        return;
+      using T = std::decay_t<decltype(arg)>;
+      napi_value tag;
+      s = internal::CreateStringFromUtf8(env, internal::GetTag<T>(),
+                                         internal::TagLength(
+                                             internal::GetTag<T>()),
+                                         &tag);
+      if (s == napi_ok)
+        s = napi_set_named_property(env, *result, key, tag);
+    }, value.variant());
+    return s;
+  }
+
+  static std::optional<V> FromNode(napi_env env, napi_value value) {
+    if (!internal::IsObject(env, value))
+      return std::nullopt;
+    napi_value tag;
+    if (napi_get_named_property(env, value, key, &tag) != napi_ok)
+      return std::nullopt;
+    // Strings longer than all tags can not match.
+    char buffer[Table::kMaxTagLength + 5];
+    size_t length;
+    if (napi_get_value_string_utf8(env, tag, buffer, sizeof(buffer),
+                                   &length) != napi_ok ||
+        !internal::IsUtf8Complete(length, sizeof(buffer))) {
+      return std::nullopt;
+    }
+    int index = Table::Find(buffer, length);
+    if (index < 0)
+      return std::nullopt;
+    using FromNodeFunc = std::optional<V> (*)(napi_env, napi_value);
+    static constexpr FromNodeFunc kConverters[] = {&FromNodeAs<Alts>...};
+    return kConverters[index](env, value);
+  }
+
+ private:
+  template<typename T>
+  static std::optional<V> FromNodeAs(napi_env env, napi_value value) {
+    std::optional<T> result = FromNodeTo<T>(env, value);
+    if (!result)
+      return std::nullopt;
+    return V(std::in_place_type<T>, std::move(*result));
+  }
+};
+
+}  // namespace ki
+
+#endif  // SRC_TAGGED_H_
@@ -0,0 +1,254 @@
+// Copyright (c) zcbenz.
+// Licensed under the MIT License.
+
+#ifndef SRC_TASK_RUNNER_H_
+#define SRC_TASK_RUNNER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "src/napi_util.h"
+
+namespace ki {
+
+namespace internal {
+
+// A multi-producer single-consumer queue of tasks to be run on the JS thread.
+// Posting is lock-free, and the JS thread is only woken up once for all the
+// tasks posted before it drains the queue.
+//
+// The queues are registered in a global list and never freed, so they can be
+// looked up from any thread without locking. The tasks are freed and the
+// threadsafe function is closed when the environment is torn down.
+class TaskQueue {
+ public:
+  static TaskQueue* Get(napi_env env) {
+    if (TaskQueue* queue = Find(env))
+      return queue;
+    auto* queue = new TaskQueue(env);
+    if (!queue->Init()) {
+      delete queue;
+      return nullptr;
+    }
+    queue->next_ = Registry().load();
+    while (!Registry().compare_exchange_weak(queue->next_, queue)) {}
+    return queue;
+  }
+
+  // Find the queue of |env|, can be called from any thread.
+  static TaskQueue* Find(napi_env env) {
+    // Newer queues are in front, in case the address of |env| is reused.
+    for (TaskQueue* queue = Registry().load(); queue; queue = queue->next_) {
+      if (queue->env_ == env && !queue->closed_)
+        return queue;
+    }
+    return nullptr;
+  }
+
+  // Tasks posted with the same non-null |key| before the queue is drained
+  // replace the earlier ones.
+  bool Post(std::function<void()> task, const void* key = nullptr) {
+    posting_++;
+    if (closed_) {
+      posting_--;
+      return false;
+    }
+    auto* node = new Node{std::move(task), key, head_.load()};
+    while (!head_.compare_exchange_weak(node->next, node)) {}
+    if (!wakeup_pending_.exchange(true))
+      napi_call_threadsafe_function(tsfn_, nullptr, napi_tsfn_nonblocking);
+    posting_--;
+    return true;
+  }
+
+  // The event loop is kept alive while there are TaskRunners, the first one
+  // is always created on the JS thread.
+  void AddRunner() {
+    if (runners_++ == 0 && !referenced_) {
+      napi_ref_threadsafe_function(env_, tsfn_);
+      referenced_ = true;
+    }
+  }
+
+  void RetainRunner() {
+    runners_++;
+  }
+
+  void ReleaseRunner() {
+    if (--runners_ > 0)
+      return;
+    Post([this]() {
+      if (runners_ == 0 && referenced_) {
+        napi_unref_threadsafe_function(env_, tsfn_);
+        referenced_ = false;
+      }
+    });
+  }
+
+ private:
+  struct Node {
+    std::function<void()> task;
+    const void* key;
+    Node* next;
+  };
+
+  static std::atomic<TaskQueue*>& Registry() {
+    static std::atomic<TaskQueue*> registry{nullptr};
+    return registry;
+  }
+
+  explicit TaskQueue(napi_env env) : env_(env) {}
+
+  bool Init() {
+    napi_value resource_name;
+    napi_status s = napi_create_string_utf8(env_, "TaskQueue",
+                                            NAPI_AUTO_LENGTH, &resource_name);
+    if (s != napi_ok)
+      return false;
+    s = napi_create_threadsafe_function(
+        env_, nullptr, nullptr, resource_name, 0, 1, this, &Finalize, this,
+        &Drain, &tsfn_);
+    if (s != napi_ok)
+      return false;
+    // Referenced when there are TaskRunners.
+    napi_unref_threadsafe_function(env_, tsfn_);
+    return true;
+  }
+
+  // Take all tasks in the order they were posted.
+  std::vector<Node*> TakeAll() {
+    std::vector<Node*> nodes;
+    for (Node* node = head_.exchange(nullptr); node; node = node->next)
+      nodes.push_back(node);
+    std::reverse(nodes.begin(), nodes.end());
+    return nodes;
+  }
+
+  static void Drain(napi_env env, napi_value, void* context, void*) {
+    // The environment is being torn down, tasks are freed in Finalize.
+    if (!env)
+      return;
+    auto* self = static_cast<TaskQueue*>(context);
+    // Reset the flag first so tasks posted from now on wake up again.
+    self->wakeup_pending_ = false;
+    std::vector<Node*> nodes = self->TakeAll();
+    // Only keep the latest task of each key.
+    std::unordered_set<const void*> keys;
+    for (auto it = nodes.rbegin(); it != nodes.rend(); ++it) {
+      if ((*it)->key && !keys.insert((*it)->key).second) {
+        delete *it;
+        *it = nullptr;
+      }
+    }
+    CallbackBatchScope batch_scope(env, "TaskQueue");
+    for (Node* node : nodes) {
+      if (!node)
+        continue;
+      HandleScope handle_scope(env);
+      node->task();
+      delete node;
+    }
+  }
+
+  static void Finalize(napi_env, void* data, void*) {
+    auto* self = static_cast<TaskQueue*>(data);
+    self->closed_ = true;
+    // Wait for the posts that have not seen the flag.
+    while (self->posting_ > 0)
+      std::this_thread::yield();
+    for (Node* node : self->TakeAll())
+      delete node;
+  }
+
+  napi_env env_;
+  napi_threadsafe_function tsfn_ = nullptr;
+  TaskQueue* next_ = nullptr;
+  std::atomic<Node*> head_{nullptr};
+  std::atomic<bool> wakeup_pending_{false};
+  std::atomic<bool> closed_{false};
+  std::atomic<int> posting_{0};
+  std::atomic<int> runners_{0};
+  // Only accessed on the JS thread.
+  bool referenced_ = false;
+};
+
+}  // namespace internal
+
+// Posts tasks to the JS thread of an environment, can be copied and used from
+// any thread. The tasks are run in the order they were posted, tasks posted
+// after the environment is torn down are dropped.
+//
+// The event loop is kept alive until all copies are destroyed.
+class TaskRunner {
+ public:
+  TaskRunner() = default;
+
+  TaskRunner(const TaskRunner& other) : queue_(other.queue_) {
+    if (queue_)
+      queue_->RetainRunner();
+  }
+
+  TaskRunner(TaskRunner&& other) : queue_(other.queue_) {
+    other.queue_ = nullptr;
+  }
+
+  ~TaskRunner() {
+    if (queue_)
+      queue_->ReleaseRunner();
+  }
+
+  TaskRunner& operator=(TaskRunner other) {
+    std::swap(queue_, other.queue_);
+    return *this;
+  }
+
+  bool PostTask(std::function<void()> task) const {
+    return queue_ && queue_->Post(std::move(task));
+  }
+
+  // Only the latest of the tasks posted with the same |key| before the JS
+  // thread wakes up gets run, useful for notifying state changes.
+  bool PostTask(const void* key, std::function<void()> task) const {
+    return queue_ && queue_->Post(std::move(task), key);
+  }
+
+  explicit operator bool() const { return !!queue_; }
+
+ private:
+  explicit TaskRunner(internal::TaskQueue* queue) : queue_(queue) {
+    if (queue_)
+      queue_->AddRunner();
+  }
+
+  friend TaskRunner GetTaskRunner(napi_env env);
+
+  internal::TaskQueue* queue_ = nullptr;
+};
+
+// Must be called on the JS thread.
+inline TaskRunner GetTaskRunner(napi_env env) {
+  return TaskRunner(internal::TaskQueue::Get(env));
+}
+
+// Can be called from any thread, but GetTaskRunner must have been called for
+// |env| on the JS thread before, otherwise the task is dropped. Note that the
+// task might never run if there is no TaskRunner keeping the event loop alive.
+inline bool PostTask(napi_env env, std::function<void()> task) {
+  internal::TaskQueue* queue = internal::TaskQueue::Find(env);
+  return queue && queue->Post(std::move(task));
+}
+
+inline bool PostTask(napi_env env, const void* key,
+                     std::function<void()> task) {
+  internal::TaskQueue* queue = internal::TaskQueue::Find(env);
+  return queue && queue->Post(std::move(task), key);
+}
+
+}  // namespace ki
+
+#endif  // SRC_TASK_RUNNER_H_
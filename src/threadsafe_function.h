@@ -0,0 +1,194 @@
+// Copyright (c) zcbenz.
+// Licensed under the MIT License.
+
+#ifndef SRC_THREADSAFE_FUNCTION_H_
+#define SRC_THREADSAFE_FUNCTION_H_
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+#include "src/callback_internal.h"
+
+namespace ki {
+
+// A JS function that can be called from any thread, for example:
+//   void Download(std::string url, ThreadSafeFunction<void(int)> progress) {
+//     std::thread([=]() { progress(50); progress(100); }).detach();
+//   }
+// The C++ arguments are moved into a queue and converted on the JS thread.
+// Calls made before the JS thread wakes up are delivered in one batch, and the
+// calls are dropped if the environment has been torn down.
+//
+// With a non-zero |max_queue_size| the queue is bounded, a full queue blocks
+// the caller in BlockingCall and fails the call in NonBlockingCall. Note that
+// blocking on the JS thread would never return, as the queue is drained there.
+//
+// The function keeps the event loop alive until all copies are destroyed.
+template<typename Sig>
+class ThreadSafeFunction {};
+
+template<typename... ArgTypes>
+class ThreadSafeFunction<void(ArgTypes...)> {
+ public:
+  // Must be called on the JS thread.
+  static std::optional<ThreadSafeFunction> Create(napi_env env,
+                                                  napi_value func,
+                                                  size_t max_queue_size = 0) {
+    napi_valuetype type;
+    if (napi_typeof(env, func, &type) != napi_ok || type != napi_function)
+      return std::nullopt;
+    napi_value resource_name;
+    napi_status s = napi_create_string_utf8(env, "ThreadSafeFunction",
+                                            NAPI_AUTO_LENGTH, &resource_name);
+    if (s != napi_ok)
+      return std::nullopt;
+    auto state = std::make_shared<State>(max_queue_size);
+    // Owned by the napi_threadsafe_function and freed in its finalizer.
+    auto context = std::make_unique<std::shared_ptr<State>>(state);
+    s = napi_create_threadsafe_function(
+        env, func, nullptr, resource_name, 0, 1, context.get(), &Finalize,
+        context.get(), &CallJS, &state->tsfn);
+    if (s != napi_ok)
+      return std::nullopt;
+    context.release();
+    ThreadSafeFunction result;
+    result.handle_ = std::make_shared<Handle>(std::move(state));
+    return result;
+  }
+
+  ThreadSafeFunction() = default;
+
+  // Queue a call, waiting for space when the queue is full. Returns false if
+  // the function has been closed.
+  bool BlockingCall(ArgTypes... args) const {
+    return Enqueue(true, std::move(args)...);
+  }
+
+  // Queue a call, returns false if the queue is full or the function has been
+  // closed.
+  bool NonBlockingCall(ArgTypes... args) const {
+    return Enqueue(false, std::move(args)...);
+  }
+
+  bool operator()(ArgTypes... args) const {
+    return Enqueue(true, std::move(args)...);
+  }
+
+  explicit operator bool() const { return !!handle_; }
+
+ private:
+  using ArgsTuple = std::tuple<std::decay_t<ArgTypes>...>;
+
+  struct State {
+    explicit State(size_t max_queue_size) : max_queue_size(max_queue_size) {}
+
+    std::mutex mutex;
+    std::condition_variable queue_not_full;
+    std::deque<ArgsTuple> queue;
+    size_t max_queue_size;
+    // Whether the JS thread has been asked to drain the queue.
+    bool wakeup_pending = false;
+    // Set when released or when the environment is torn down.
+    bool closed = false;
+    napi_threadsafe_function tsfn = nullptr;
+  };
+
+  // Shared by all copies of the ThreadSafeFunction, releases the
+  // napi_threadsafe_function when the last copy is gone.
+  struct Handle {
+    explicit Handle(std::shared_ptr<State> state) : state(std::move(state)) {}
+    ~Handle() {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (state->closed)
+        return;
+      napi_release_threadsafe_function(state->tsfn, napi_tsfn_release);
+      state->closed = true;
+      state->queue_not_full.notify_all();
+    }
+
+    std::shared_ptr<State> state;
+  };
+
+  template<typename... Args>
+  bool Enqueue(bool blocking, Args&&... args) const {
+    if (!handle_)
+      return false;
+    State* state = handle_->state.get();
+    std::unique_lock<std::mutex> lock(state->mutex);
+    if (state->max_queue_size > 0) {
+      while (!state->closed && state->queue.size() >= state->max_queue_size) {
+        if (!blocking)
+          return false;
+        state->queue_not_full.wait(lock);
+      }
+    }
+    if (state->closed)
+      return false;
+    state->queue.emplace_back(std::forward<Args>(args)...);
+    if (state->wakeup_pending)
+      return true;
+    // The lock is kept so the tsfn can not be finalized meanwhile.
+    napi_status s = napi_call_threadsafe_function(state->tsfn, nullptr,
+                                                  napi_tsfn_nonblocking);
+    if (s != napi_ok) {
+      state->queue.pop_back();
+      return false;
+    }
+    state->wakeup_pending = true;
+    return true;
+  }
+
+  static void CallJS(napi_env env, napi_value func, void* context, void*) {
+    State* state = static_cast<std::shared_ptr<State>*>(context)->get();
+    std::deque<ArgsTuple> queue;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      queue.swap(state->queue);
+      state->wakeup_pending = false;
+      state->queue_not_full.notify_all();
+    }
+    // The environment is being torn down.
+    if (!env || !func)
+      return;
+    CallbackBatchScope batch_scope(env, "ThreadSafeFunction");
+    for (ArgsTuple& args : queue) {
+      HandleScope handle_scope(env);
+      std::apply([env, func](auto&&... raw) {
+        napi_value argv[] = {ToNodeValue(env, std::move(raw))..., nullptr};
+        napi_value result;
+        internal::CallJSFunction(env, func, sizeof...(raw), argv, &result);
+      }, args);
+    }
+  }
+
+  static void Finalize(napi_env, void* data, void*) {
+    std::unique_ptr<std::shared_ptr<State>> context(
+        static_cast<std::shared_ptr<State>*>(data));
+    State* state = context->get();
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->closed = true;
+    state->queue.clear();
+    state->queue_not_full.notify_all();
+  }
+
+  std::shared_ptr<Handle> handle_;
+};
+
+template<typename... ArgTypes>
+struct Type<ThreadSafeFunction<void(ArgTypes...)>> {
+  static constexpr const char* name = "Function";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_function);
+  static inline std::optional<ThreadSafeFunction<void(ArgTypes...)>> FromNode(
+      napi_env env, napi_value value) {
+    return ThreadSafeFunction<void(ArgTypes...)>::Create(env, value);
+  }
+};
+
+}  // namespace ki
+
+#endif  // SRC_THREADSAFE_FUNCTION_H_
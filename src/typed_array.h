@@ -0,0 +1,161 @@
+// Copyright (c) zcbenz.
+// Licensed under the MIT License.
+
+#ifndef SRC_TYPED_ARRAY_H_
+#define SRC_TYPED_ARRAY_H_
+
+#include <cstring>
+#include <vector>
+
+#include "src/iterator.h"
+
+namespace ki {
+
+namespace internal {
+
+// Map arithmetic types to the TypedArray types with same memory layout, -1 if
+// there is no such TypedArray.
+template<typename T>
+constexpr int GetTypedArrayType() {
+  if constexpr (std::is_same_v<T, bool> || !std::is_arithmetic_v<T>) {
+    return -1;
+  } else if constexpr (std::is_floating_point_v<T>) {
+    if constexpr (sizeof(T) == 4)
+      return napi_float32_array;
+    else if constexpr (sizeof(T) == 8)
+      return napi_float64_array;
+    else
+      return -1;
+  } else if constexpr (sizeof(T) == 1) {
+    return std::is_signed_v<T> ? napi_int8_array : napi_uint8_array;
+  } else if constexpr (sizeof(T) == 2) {
+    return std::is_signed_v<T> ? napi_int16_array : napi_uint16_array;
+  } else if constexpr (sizeof(T) == 4) {
+    return std::is_signed_v<T> ? napi_int32_array : napi_uint32_array;
+  } else if constexpr (sizeof(T) == 8) {
+    return std::is_signed_v<T> ? napi_bigint64_array : napi_biguint64_array;
+  } else {
+    return -1;
+  }
+}
+
+template<typename T>
+inline constexpr bool is_typed_array_element_v = GetTypedArrayType<T>() >= 0;
+
+// Copy the elements of |value| to |out| if it is a TypedArray of T, the E is
+// a type with the same memory layout of T.
+template<typename E, typename T = E>
+bool ReadTypedArray(napi_env env, napi_value value, std::vector<E>* out) {
+  static_assert(is_typed_array_element_v<T> && sizeof(T) == sizeof(E));
+  bool is_typedarray = false;
+  if (napi_is_typedarray(env, value, &is_typedarray) != napi_ok ||
+      !is_typedarray) {
+    return false;
+  }
+  napi_typedarray_type type;
+  size_t length;
+  void* data;
+  if (napi_get_typedarray_info(env, value, &type, &length, &data,
+                               nullptr, nullptr) != napi_ok ||
+      type != GetTypedArrayType<T>()) {
+    return false;
+  }
+  out->resize(length);
+  if (length > 0)
+    std::memcpy(out->data(), data, length * sizeof(T));
+  return true;
+}
+
+// Create a TypedArray of T with one copy of |size| elements.
+template<typename T>
+napi_status CreateTypedArray(napi_env env, const T* elements, size_t size,
+                             napi_value* result) {
+  static_assert(is_typed_array_element_v<T>);
+  void* data;
+  napi_value buffer;
+  napi_status s = napi_create_arraybuffer(env, size * sizeof(T), &data,
+                                          &buffer);
+  if (s != napi_ok)
+    return s;
+  if (size > 0)
+    std::memcpy(data, elements, size * sizeof(T));
+  return napi_create_typedarray(
+      env, static_cast<napi_typedarray_type>(GetTypedArrayType<T>()), size,
+      buffer, 0, result);
+}
+
+}  // namespace internal
+
+// A vector that is converted to a TypedArray with same element type:
+//   TypedArray<double> GetSamples();  // returns Float64Array
+// Passing JS Arrays to it is also allowed, which is slower.
+template<typename T>
+class TypedArray : public std::vector<T> {
+ public:
+  static_assert(internal::is_typed_array_element_v<T>,
+                "There is no TypedArray for the element type.");
+
+  using std::vector<T>::vector;
+
+  TypedArray() = default;
+  TypedArray(const std::vector<T>& vec) : std::vector<T>(vec) {}  // NOLINT
+  TypedArray(std::vector<T>&& vec) : std::vector<T>(std::move(vec)) {}  // NOLINT
+};
+
+template<typename T>
+struct Type<TypedArray<T>> {
+  static constexpr const char* name = "TypedArray";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_object);
+  static inline napi_status ToNode(napi_env env,
+                                   const TypedArray<T>& value,
+                                   napi_value* result) {
+    return internal::CreateTypedArray(env, value.data(), value.size(), result);
+  }
+  static std::optional<TypedArray<T>> FromNode(napi_env env,
+                                               napi_value value) {
+    TypedArray<T> result;
+    if (internal::ReadTypedArray(env, value, &result))
+      return result;
+    if (!IterateArray<T>(env, value,
+                         [&](uint32_t i, T value) {
+                           result.push_back(value);
+                           return true;
+                         })) {
+      return std::nullopt;
+    }
+    return result;
+  }
+};
+
+// Vectors of BigInt are converted to BigInt64Array and BigUint64Array.
+template<typename T>
+struct Type<std::vector<BigInt<T>>> {
+  static_assert(sizeof(BigInt<T>) == sizeof(T));
+  static constexpr const char* name = std::is_signed_v<T> ? "BigInt64Array"
+                                                          : "BigUint64Array";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_object);
+  static inline napi_status ToNode(napi_env env,
+                                   const std::vector<BigInt<T>>& value,
+                                   napi_value* result) {
+    return internal::CreateTypedArray(
+        env, reinterpret_cast<const T*>(value.data()), value.size(), result);
+  }
+  static std::optional<std::vector<BigInt<T>>> FromNode(napi_env env,
+                                                        napi_value value) {
+    std::vector<BigInt<T>> result;
+    if (internal::ReadTypedArray<BigInt<T>, T>(env, value, &result))
+      return result;
+    if (!IterateArray<BigInt<T>>(env, value,
+                                 [&](uint32_t i, BigInt<T> value) {
+                                   result.push_back(value);
+                                   return true;
+                                 })) {
+      return std::nullopt;
+    }
+    return result;
+  }
+};
+
+}  // namespace ki
+
+#endif  // SRC_TYPED_ARRAY_H_
@@ -10,6 +10,7 @@
 #include <cstring>
 #include <optional>
 
+#include "src/string_util.h"
 #include "src/template_util.h"
 
 namespace ki {
@@ -20,6 +21,69 @@ struct TypeBridge {};
 template<typename T, typename Enable = void>
 struct Type {};
 
+// Bit mask of JS value types, a Type<T> can declare the types its FromNode may
+// accept with |accepted_types|, which allows converters like std::variant to
+// skip the alternatives that can not match:
+//   static constexpr uint32_t accepted_types = ValueTypeMask(napi_number);
+constexpr uint32_t ValueTypeMask(napi_valuetype type) {
+  return 1u << type;
+}
+
+template<typename... Rest>
+constexpr uint32_t ValueTypeMask(napi_valuetype type, Rest... rest) {
+  return ValueTypeMask(type) | ValueTypeMask(rest...);
+}
+
+// Types without |accepted_types| may accept anything.
+inline constexpr uint32_t kAnyValueType = ~0u;
+
+namespace internal {
+
+template<typename T, typename Enable = void>
+struct AcceptedValueTypes {
+  static constexpr uint32_t value = kAnyValueType;
+};
+
+template<typename T>
+struct AcceptedValueTypes<T, std::void_t<decltype(Type<T>::accepted_types)>> {
+  static constexpr uint32_t value = Type<T>::accepted_types;
+};
+
+template<typename T>
+inline constexpr uint32_t accepted_value_types_v = AcceptedValueTypes<T>::value;
+
+// The env passed to the finalizers of napi_wrap, napi_add_finalizer and
+// external values, which becomes a const node_api_basic_env when building with
+// NAPI_EXPERIMENTAL on recent versions of Node, and is deduced from the
+// signature of napi_wrap as older headers do not declare node_api_basic_env.
+template<typename F>
+struct FinalizeCallbackOf;
+
+template<typename Finalize, typename... Rest>
+struct FinalizeCallbackOf<napi_status (*)(napi_env, napi_value, void*,
+                                          Finalize, Rest...)> {
+  using Type = Finalize;
+};
+
+template<typename F>
+struct FinalizerEnvOf;
+
+template<typename Env, typename... Rest>
+struct FinalizerEnvOf<void (*)(Env, Rest...)> {
+  using Type = Env;
+};
+
+using FinalizerEnv = typename FinalizerEnvOf<
+    typename FinalizeCallbackOf<decltype(&napi_wrap)>::Type>::Type;
+
+// Finalizers only call the APIs allowed in GC, like deleting references, but
+// some of them are made through helpers taking napi_env.
+inline napi_env FromFinalizerEnv(FinalizerEnv env) {
+  return const_cast<napi_env>(env);
+}
+
+}  // namespace internal
+
 template<>
 struct Type<napi_value> {
   static constexpr const char* name = "Value";
@@ -63,6 +127,7 @@ struct Type<void*> {
 template<>
 struct Type<uint8_t> {
   static constexpr const char* name = "Integer";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_number);
   static inline napi_status ToNode(napi_env env,
                                    uint8_t value,
                                    napi_value* result) {
@@ -80,6 +145,7 @@ struct Type<uint8_t> {
 template<>
 struct Type<uint16_t> {
   static constexpr const char* name = "Integer";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_number);
   static inline napi_status ToNode(napi_env env,
                                    uint16_t value,
                                    napi_value* result) {
@@ -97,6 +163,7 @@ struct Type<uint16_t> {
 template<>
 struct Type<int8_t> {
   static constexpr const char* name = "Integer";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_number);
   static inline napi_status ToNode(napi_env env,
                                    int8_t value,
                                    napi_value* result) {
@@ -113,6 +180,7 @@ struct Type<int8_t> {
 template<>
 struct Type<int16_t> {
   static constexpr const char* name = "Integer";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_number);
   static inline napi_status ToNode(napi_env env,
                                    int16_t value,
                                    napi_value* result) {
@@ -130,6 +198,7 @@ struct Type<int16_t> {
 template<>
 struct Type<int32_t> {
   static constexpr const char* name = "Integer";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_number);
   static inline napi_status ToNode(napi_env env,
                                    int32_t value,
                                    napi_value* result) {
@@ -147,6 +216,7 @@ struct Type<int32_t> {
 template<>
 struct Type<uint32_t> {
   static constexpr const char* name = "Integer";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_number);
   static inline napi_status ToNode(napi_env env,
                                    uint32_t value,
                                    napi_value* result) {
@@ -164,6 +234,7 @@ struct Type<uint32_t> {
 template<>
 struct Type<int64_t> {
   static constexpr const char* name = "Integer";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_number);
   static inline napi_status ToNode(napi_env env,
                                    int64_t value,
                                    napi_value* result) {
@@ -182,6 +253,7 @@ struct Type<int64_t> {
 template<>
 struct Type<size_t> {
   static constexpr const char* name = "Integer";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_number);
   static inline napi_status ToNode(napi_env env,
                                    size_t value,
                                    napi_value* result) {
@@ -200,6 +272,7 @@ struct Type<size_t> {
 template<>
 struct Type<float> {
   static constexpr const char* name = "Number";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_number);
   static inline napi_status ToNode(napi_env env,
                                    float value,
                                    napi_value* result) {
@@ -217,6 +290,7 @@ struct Type<float> {
 template<>
 struct Type<double> {
   static constexpr const char* name = "Number";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_number);
   static inline napi_status ToNode(napi_env env,
                                    double value,
                                    napi_value* result) {
@@ -234,6 +308,7 @@ struct Type<double> {
 template<>
 struct Type<uint64_t> {
   static constexpr const char* name = "Integer";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_number);
   static inline napi_status ToNode(napi_env env,
                                    uint64_t value,
                                    napi_value* result) {
@@ -248,9 +323,65 @@ struct Type<uint64_t> {
   }
 };
 
+// Opt-in lossless conversion between 64-bit integers and JS BigInt, while
+// int64_t and uint64_t are converted to Numbers by default:
+//   ki::BigInt<uint64_t> GetId();
+// Numbers are also accepted when converting from JS.
+template<typename T>
+struct BigInt {
+  static_assert(std::is_integral_v<T> && sizeof(T) == 8,
+                "BigInt only supports 64-bit integers.");
+
+  constexpr BigInt() = default;
+  constexpr BigInt(T value) : value(value) {}  // NOLINT
+
+  constexpr operator T() const { return value; }
+
+  T value = 0;
+};
+
+template<typename T>
+struct Type<BigInt<T>> {
+  static constexpr const char* name = "BigInt";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_number,
+                                                         napi_bigint);
+  static inline napi_status ToNode(napi_env env,
+                                   BigInt<T> value,
+                                   napi_value* result) {
+    if constexpr (std::is_signed_v<T>)
+      return napi_create_bigint_int64(env, value.value, result);
+    else
+      return napi_create_bigint_uint64(env, value.value, result);
+  }
+  static inline std::optional<BigInt<T>> FromNode(napi_env env,
+                                                  napi_value value) {
+    using Integer = std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>;
+    napi_valuetype type;
+    if (napi_typeof(env, value, &type) != napi_ok)
+      return std::nullopt;
+    if (type != napi_bigint) {
+      std::optional<Integer> result = Type<Integer>::FromNode(env, value);
+      if (!result)
+        return std::nullopt;
+      return BigInt<T>(static_cast<T>(*result));
+    }
+    Integer result;
+    bool lossless;
+    napi_status s;
+    if constexpr (std::is_signed_v<T>)
+      s = napi_get_value_bigint_int64(env, value, &result, &lossless);
+    else
+      s = napi_get_value_bigint_uint64(env, value, &result, &lossless);
+    if (s != napi_ok || !lossless)
+      return std::nullopt;
+    return BigInt<T>(static_cast<T>(result));
+  }
+};
+
 template<>
 struct Type<bool> {
   static constexpr const char* name = "Boolean";
+  static constexpr uint32_t accepted_types = ValueTypeMask(napi_boolean);
   static inline napi_status ToNode(napi_env env,
                                    bool value,
                                    napi_value* result) {
@@ -271,7 +402,8 @@ struct Type<const char*> {
   static inline napi_status ToNode(napi_env env,
                                    const char* value,
                                    napi_value* result) {
-    return napi_create_string_utf8(env, value, NAPI_AUTO_LENGTH, result);
+    return internal::CreateStringFromUtf8(env, value, NAPI_AUTO_LENGTH,
+                                          result);
   }
 };
 
@@ -281,7 +413,8 @@ struct Type<char*> {
   static inline napi_status ToNode(napi_env env,
                                    const char* value,
                                    napi_value* result) {
-    return napi_create_string_utf8(env, value, NAPI_AUTO_LENGTH, result);
+    return internal::CreateStringFromUtf8(env, value, NAPI_AUTO_LENGTH,
+                                          result);
   }
 };
 
@@ -291,7 +424,7 @@ struct Type<char[n]> {
   static inline napi_status ToNode(napi_env env,
                                    const char* value,
                                    napi_value* result) {
-    return napi_create_string_utf8(env, value, n - 1, result);
+    return internal::CreateStringFromUtf8(env, value, n - 1, result);
   }
 };
 
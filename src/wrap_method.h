@@ -27,14 +27,16 @@ inline void RunRefFunc(const std::function<void(Arguments, napi_value)>& func,
 template<typename T,
          typename W,
          typename = typename std::enable_if<
-             internal::IsFunctionConversionSupported<T>::value>::type>
+             internal::IsFunctionConversionSupported<
+                 std::decay_t<T>>::value>::type>
 inline std::function<napi_value(Arguments)>
 WrapMethod(T&& func, W&& ref_func) {
-  auto holder = internal::CallbackHolderFactory<T>::Create(
-      std::move(func), FunctionArgumentIsWeakRef);
+  using Factory = internal::CallbackHolderFactory<std::decay_t<T>>;
+  auto holder = Factory::Create(std::forward<T>(func),
+                                FunctionArgumentIsWeakRef);
   return [holder = std::move(holder),
           ref_func = std::move(ref_func)](Arguments args) {
-    using RunType = typename internal::CallbackHolderFactory<T>::RunType;
+    using RunType = typename Factory::RunType;
     using Runner = internal::ReturnToNode<RunType>;
     bool success = false;
     napi_value ret = Runner::InvokeWithHolder(&args, &holder, &success);
@@ -0,0 +1,138 @@
+// Copyright (c) zcbenz.
+// Licensed under the MIT License.
+
+#ifndef SRC_WRAPPABLE_H_
+#define SRC_WRAPPABLE_H_
+
+#include <atomic>
+
+#include "src/instance_data.h"
+
+namespace ki {
+
+namespace internal {
+struct WrappableAccess;
+}
+
+// Native objects inheriting from Wrappable store the reference to their JS
+// wrapper inline, so converting them to JS again only reads a field instead of
+// looking up the wrappers registry:
+//   class Node : public ki::Wrappable { ... };
+// Same with other wrapped objects, the object must be alive until its wrapper
+// is finalized. The wrapper is not copied when copying the object.
+// An object can be wrapped in multiple envs on different threads, or as
+// multiple types unrelated in JS, the inline slot is owned by the first wrapper
+// and other wrappers are stored in InstanceData.
+class Wrappable {
+ protected:
+  Wrappable() = default;
+  ~Wrappable() = default;
+
+  Wrappable(const Wrappable&) {}
+  Wrappable& operator=(const Wrappable&) { return *this; }
+
+ private:
+  friend struct internal::WrappableAccess;
+
+  // The env owning the inline slot, which is claimed atomically, and other
+  // fields are only accessed on the thread of the owner env.
+  std::atomic<napi_env> wrapper_env_{nullptr};
+  const void* wrapper_type_ = nullptr;
+  napi_ref wrapper_ref_ = nullptr;
+};
+
+namespace internal {
+
+struct WrappableAccess {
+  static bool Claim(napi_env env, Wrappable* ptr) {
+    napi_env expected = nullptr;
+    return ptr->wrapper_env_.compare_exchange_strong(
+        expected, env, std::memory_order_acquire, std::memory_order_relaxed);
+  }
+
+  static void Release(Wrappable* ptr) {
+    ptr->wrapper_env_.store(nullptr, std::memory_order_release);
+  }
+
+  static bool Get(napi_env env, const void* type, const Wrappable* ptr,
+                  napi_value* result) {
+    if (ptr->wrapper_env_.load(std::memory_order_acquire) != env ||
+        ptr->wrapper_type_ != type || !ptr->wrapper_ref_) {
+      return false;
+    }
+    *result = nullptr;
+    napi_get_reference_value(env, ptr->wrapper_ref_, result);
+    return *result != nullptr;
+  }
+
+  static void Set(const void* type, Wrappable* ptr, napi_ref ref) {
+    ptr->wrapper_type_ = type;
+    ptr->wrapper_ref_ = ref;
+  }
+
+  static void Clear(napi_env env, Wrappable* ptr) {
+    napi_delete_reference(env, ptr->wrapper_ref_);
+    ptr->wrapper_type_ = nullptr;
+    ptr->wrapper_ref_ = nullptr;
+    Release(ptr);
+  }
+};
+
+// Helpers for storing wrappers, the wrapper of Wrappable objects is stored
+// inline unless it is already taken, by wrappers of other envs or types, or
+// wrappers that have been collected but not finalized yet, and other wrappers
+// are stored in InstanceData. Whether the wrapper is stored inline must be
+// decided before napi_wrap so the finalizer knows where to delete it, and the
+// claimed slot must be released if wrapping fails.
+template<typename T>
+bool ClaimInlineWrapper(InstanceData* instance_data, T* ptr) {
+  if constexpr (std::is_base_of_v<Wrappable, T>)
+    return WrappableAccess::Claim(instance_data->env(), ptr);
+  else
+    return false;
+}
+
+template<typename T>
+void ReleaseInlineWrapper(T* ptr) {
+  if constexpr (std::is_base_of_v<Wrappable, T>)
+    WrappableAccess::Release(ptr);
+}
+
+template<typename T>
+bool GetWrapper(InstanceData* instance_data, T* ptr, napi_value* result) {
+  if constexpr (std::is_base_of_v<Wrappable, T>) {
+    if (WrappableAccess::Get(instance_data->env(),
+                             InstanceData::GetWrapperTypeId<T>(), ptr, result))
+      return true;
+  }
+  return instance_data->GetWrapper<T>(ptr, result);
+}
+
+template<typename T>
+void AddWrapper(InstanceData* instance_data, T* ptr, napi_ref ref,
+                bool store_inline) {
+  if constexpr (std::is_base_of_v<Wrappable, T>) {
+    if (store_inline) {
+      WrappableAccess::Set(InstanceData::GetWrapperTypeId<T>(), ptr, ref);
+      return;
+    }
+  }
+  instance_data->AddWrapper<T>(ptr, ref);
+}
+
+template<typename T>
+void DeleteWrapper(napi_env env, T* ptr, bool stored_inline) {
+  if constexpr (std::is_base_of_v<Wrappable, T>) {
+    if (stored_inline) {
+      WrappableAccess::Clear(env, ptr);
+      return;
+    }
+  }
+  InstanceData::Get(env)->DeleteWrapper<T>(ptr);
+}
+
+}  // namespace internal
+
+}  // namespace ki
+
+#endif  // SRC_WRAPPABLE_H_
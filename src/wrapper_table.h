@@ -0,0 +1,130 @@
+// Copyright (c) zcbenz.
+// Licensed under the MIT License.
+
+#ifndef SRC_WRAPPER_TABLE_H_
+#define SRC_WRAPPER_TABLE_H_
+
+#include <node_api.h>
+
+#include <cstdint>
+#include <memory>
+
+namespace ki {
+
+namespace internal {
+
+// Hash table storing the napi_ref of wrappers, keyed by the type id and the
+// address of native object. It uses open addressing with linear probing, so
+// each entry is stored inline without node allocations, and removed entries
+// are filled by shifting the following entries back instead of tombstones.
+class WrapperTable {
+ public:
+  WrapperTable() = default;
+
+  WrapperTable& operator=(const WrapperTable&) = delete;
+  WrapperTable(const WrapperTable&) = delete;
+
+  // Add the |ref| and return true, or return false if the key already exists.
+  bool Add(const void* type, void* ptr, napi_ref ref) {
+    if ((size_ + 1) * 2 > capacity_)
+      Rehash(capacity_ == 0 ? kMinCapacity : capacity_ * 2);
+    Entry* entry = Find(type, ptr);
+    if (entry->type)
+      return false;
+    *entry = {type, ptr, ref};
+    size_++;
+    return true;
+  }
+
+  // Return the ref of the key, nullptr if not found.
+  napi_ref Get(const void* type, void* ptr) const {
+    if (size_ == 0)
+      return nullptr;
+    return Find(type, ptr)->ref;
+  }
+
+  // Remove the key and return its ref, nullptr if not found.
+  napi_ref Remove(const void* type, void* ptr) {
+    if (size_ == 0)
+      return nullptr;
+    Entry* entry = Find(type, ptr);
+    if (!entry->type)
+      return nullptr;
+    napi_ref ref = entry->ref;
+    Erase(entry - entries_.get());
+    size_--;
+    // Give memory back after a large amount of wrappers are collected.
+    if (capacity_ > kMinCapacity && size_ * 8 < capacity_)
+      Rehash(capacity_ / 2);
+    return ref;
+  }
+
+  size_t size() const { return size_; }
+
+ private:
+  struct Entry {
+    const void* type = nullptr;  // nullptr for empty entry
+    void* ptr = nullptr;
+    napi_ref ref = nullptr;
+  };
+
+  static constexpr size_t kMinCapacity = 16;
+
+  size_t IdealIndex(const void* type, void* ptr) const {
+    uint64_t h = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(ptr)) ^
+                 static_cast<uint64_t>(reinterpret_cast<uintptr_t>(type)) *
+                 0x9e3779b97f4a7c15ull;
+    // Finalizer of MurmurHash3.
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return static_cast<size_t>(h) & (capacity_ - 1);
+  }
+
+  // Return the entry of the key, or the empty entry where it can be inserted.
+  Entry* Find(const void* type, void* ptr) const {
+    size_t mask = capacity_ - 1;
+    for (size_t i = IdealIndex(type, ptr); ; i = (i + 1) & mask) {
+      Entry* entry = &entries_[i];
+      if (!entry->type || (entry->type == type && entry->ptr == ptr))
+        return entry;
+    }
+  }
+
+  // Empty the entry at |i| and move back the entries after it that can not be
+  // found otherwise.
+  void Erase(size_t i) {
+    size_t mask = capacity_ - 1;
+    for (size_t j = (i + 1) & mask; entries_[j].type; j = (j + 1) & mask) {
+      size_t k = IdealIndex(entries_[j].type, entries_[j].ptr);
+      // Keep the entry if its ideal index is cyclically in (i, j].
+      bool keep = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+      if (!keep) {
+        entries_[i] = entries_[j];
+        i = j;
+      }
+    }
+    entries_[i] = Entry();
+  }
+
+  void Rehash(size_t capacity) {
+    std::unique_ptr<Entry[]> old = std::move(entries_);
+    size_t old_capacity = capacity_;
+    entries_ = std::make_unique<Entry[]>(capacity);
+    capacity_ = capacity;
+    for (size_t i = 0; i < old_capacity; ++i) {
+      if (old[i].type)
+        *Find(old[i].type, old[i].ptr) = old[i];
+    }
+  }
+
+  std::unique_ptr<Entry[]> entries_;
+  size_t capacity_ = 0;
+  size_t size_ = 0;
+};
+
+}  // namespace internal
+
+}  // namespace ki
+
+#endif  // SRC_WRAPPER_TABLE_H_
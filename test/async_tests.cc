@@ -0,0 +1,108 @@
+// Copyright (c) zcbenz.
+// Licensed under the MIT License.
+
+#include <kizunapi.h>
+
+#include <thread>
+
+namespace {
+
+std::thread::id g_main_thread_id;
+
+bool IsRunInMainThread() {
+  return std::this_thread::get_id() == g_main_thread_id;
+}
+
+int Add(int a, int b) {
+  return a + b;
+}
+
+std::string Concat(const std::string& a, const std::string& b) {
+  return a + b;
+}
+
+// Records whether the argument, or any copy of it, is destroyed on a thread
+// other than the one where it was converted.
+bool g_arg_destroyed_off_thread = false;
+
+class ThreadBoundArg {
+ public:
+  ThreadBoundArg() : thread_(std::this_thread::get_id()) {}
+  ThreadBoundArg(const ThreadBoundArg& other) : thread_(other.thread_) {}
+  ThreadBoundArg& operator=(const ThreadBoundArg&) = default;
+
+  ~ThreadBoundArg() {
+    if (std::this_thread::get_id() != thread_)
+      g_arg_destroyed_off_thread = true;
+  }
+
+ private:
+  std::thread::id thread_;
+};
+
+bool ReceiveThreadBoundArg(const ThreadBoundArg& arg, int n) {
+  return !IsRunInMainThread();
+}
+
+bool IsArgDestroyedOffThread() {
+  return g_arg_destroyed_off_thread;
+}
+
+class Accumulator {
+ public:
+  int Add(int n) {
+    value_ += n;
+    return value_;
+  }
+
+ private:
+  int value_ = 0;
+};
+
+}  // namespace
+
+namespace ki {
+
+template<>
+struct Type<ThreadBoundArg> {
+  static constexpr const char* name = "ThreadBoundArg";
+  static std::optional<ThreadBoundArg> FromNode(napi_env, napi_value) {
+    return ThreadBoundArg();
+  }
+};
+
+static_assert(internal::is_js_thread_only_v<std::function<void()>>);
+static_assert(internal::is_js_thread_only_v<const Persistent&>);
+static_assert(internal::is_js_thread_only_v<napi_ref>);
+static_assert(
+    internal::is_js_thread_only_v<std::optional<std::function<int()>>>);
+static_assert(!internal::is_js_thread_only_v<const std::string&>);
+static_assert(!internal::is_js_thread_only_v<Accumulator*>);
+
+template<>
+struct Type<Accumulator> {
+  static constexpr const char* name = "Accumulator";
+  static Accumulator* Constructor() {
+    return new Accumulator;
+  }
+  static void Destructor(Accumulator* ptr) {
+    delete ptr;
+  }
+  static void Define(napi_env env, napi_value, napi_value prototype) {
+    Set(env, prototype, "add", Async(&Accumulator::Add));
+  }
+};
+
+}  // namespace ki
+
+void run_async_tests(napi_env env, napi_value binding) {
+  g_main_thread_id = std::this_thread::get_id();
+  ki::Set(env, binding,
+          "isRunInMainThread", ki::Async(&IsRunInMainThread),
+          "add", ki::Async(&Add),
+          "concat", ki::Async(&Concat),
+          "lambda", ki::Async([](int n) { return n * 2; }),
+          "receiveThreadBoundArg", ki::Async(&ReceiveThreadBoundArg),
+          "isArgDestroyedOffThread", &IsArgDestroyedOffThread,
+          "Accumulator", ki::Class<Accumulator>());
+}
@@ -0,0 +1,27 @@
+exports.runTests = async (assert, binding, {runInNewScope, gcUntil}) => {
+  assert.equal(binding.isRunInMainThread() instanceof Promise, true,
+               'Async returns a Promise')
+  assert.equal(await binding.isRunInMainThread(), false,
+               'Async runs function in threadpool')
+  assert.equal(await binding.add(1, 2), 3, 'Async passes arguments')
+  assert.equal(await binding.concat('a', 'b'), 'ab',
+               'Async passes string arguments')
+  assert.equal(await binding.lambda(21), 42, 'Async runs lambda')
+  assert.equal(await binding.receiveThreadBoundArg(null, 1), true,
+               'Async passes arguments by reference')
+  assert.equal(binding.isArgDestroyedOffThread(), false,
+               'Async destroys arguments on the JS thread')
+  assert.throws(() => binding.add('1', 2), {
+    name: 'TypeError',
+    message: 'Error processing argument at index 0, conversion failure from String to Integer.',
+  }, 'Async throws on conversion failure')
+
+  const results = await Promise.all([binding.add(1, 1), binding.add(2, 2)])
+  assert.deepEqual(results, [2, 4], 'Async runs concurrent calls')
+
+  await runInNewScope(async () => {
+    const promise = (() => new binding.Accumulator().add(8))()
+    gc()
+    assert.equal(await promise, 8, 'Async keeps this alive')
+  })
+}
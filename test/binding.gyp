@@ -17,13 +17,35 @@
       ],
       'sources': [
         'main.cc',
+        'async_tests.cc',
         'callback_tests.cc',
         'persistent_tests.cc',
         'property_tests.cc',
         'prototype_tests.cc',
+        'task_runner_tests.cc',
+        'threadsafe_function_tests.cc',
         'types_tests.cc',
         'wrap_method_tests.cc',
+        'wrapper_table_tests.cc',
       ],
-    }
+    },
+    {
+      'target_name': 'ki_experimental_tests',
+      'include_dirs': [ '<!@(node -p "require(\'..\').include_dir")' ],
+      'cflags_cc': [ '-std=c++17' ],
+      'xcode_settings': { 'OTHER_CFLAGS': [ '-std=c++17' ] },
+      'msvs_settings': {
+        'VCCLCompilerTool': {
+          'AdditionalOptions': [ '/std:c++17' ],
+        },
+      },
+      'defines': [
+        'NAPI_EXPERIMENTAL',
+        'NAPI_VERSION=9',
+      ],
+      'sources': [
+        'experimental_tests.cc',
+      ],
+    },
   ]
 }
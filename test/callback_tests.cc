@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include <kizunapi.h>
+#include <uv.h>
 
 namespace {
 
@@ -12,10 +13,78 @@ int AddOne(int input) {
   return input + 1;
 }
 
+struct Counted {};
+
+int conversion_count = 0;
+
+void TakeIntAndCounted(int, Counted) {
+}
+
+int ConversionCount() {
+  return conversion_count;
+}
+
+size_t ArgumentsLength(ki::Arguments* args) {
+  return args->Length();
+}
+
 std::string Append64(std::function<std::string()> callback) {
   return callback() + "64";
 }
 
+int SumCallResults(std::function<int(int)> callback, int times) {
+  int sum = 0;
+  for (int i = 0; i < times; ++i)
+    sum += callback(i);
+  return sum;
+}
+
+// Run |task| in a uv timer, where there is no JS on the stack.
+void RunInEventLoop(napi_env env, std::function<void()> task) {
+  struct Timer {
+    uv_timer_t handle;
+    std::function<void()> task;
+  };
+  uv_loop_t* loop;
+  napi_get_uv_event_loop(env, &loop);
+  auto* timer = new Timer{{}, std::move(task)};
+  uv_timer_init(loop, &timer->handle);
+  timer->handle.data = timer;
+  uv_timer_start(&timer->handle, [](uv_timer_t* handle) {
+    static_cast<Timer*>(handle->data)->task();
+    uv_close(reinterpret_cast<uv_handle_t*>(handle), [](uv_handle_t* handle) {
+      delete static_cast<Timer*>(handle->data);
+    });
+  }, 0, 0);
+}
+
+// The |after| is called after all the calls.
+void CallFromEventLoop(napi_env env,
+                       std::function<void(int)> callback,
+                       int times,
+                       std::function<void()> after) {
+  RunInEventLoop(env, [callback, times, after]() {
+    for (int i = 0; i < times; ++i)
+      callback(i);
+    after();
+  });
+}
+
+// The |after| is called after the batch scope is closed.
+void DispatchEvents(napi_env env,
+                    std::function<void(int)> callback,
+                    int count,
+                    std::function<void()> after) {
+  RunInEventLoop(env, [env, callback, count, after]() {
+    {
+      ki::CallbackBatchScope batch_scope(env);
+      for (int i = 0; i < count; ++i)
+        callback(i);
+    }
+    after();
+  });
+}
+
 class TestClass {
  public:
   explicit TestClass(int data) : data(data) {
@@ -53,6 +122,16 @@ void ClearStoredFunction() {
 
 namespace ki {
 
+template<>
+struct Type<Counted> {
+  static constexpr const char* name = "Counted";
+  static inline std::optional<Counted> FromNode(napi_env env,
+                                                napi_value value) {
+    conversion_count++;
+    return Counted();
+  }
+};
+
 template<>
 struct Type<TestClass*> {
   static constexpr const char* name = "TestClass";
@@ -76,13 +155,32 @@ struct Type<TestClass*> {
 void run_callback_tests(napi_env env, napi_value binding) {
   ki::Set(env, binding, "returnVoid", &ReturnVoid,
                         "addOne", &AddOne,
+                        "addOneFn", ki::Fn<&AddOne>(),
+                        "argumentsLength", &ArgumentsLength,
+                        "takeIntAndCounted", &TakeIntAndCounted,
+                        "conversionCount", &ConversionCount,
                         "append64", &Append64,
+                        "sumCallResults", &SumCallResults,
+                        "callFromEventLoop", &CallFromEventLoop,
+                        "dispatchEvents", &DispatchEvents,
                         "nullFunction", std::function<void()>());
 
   TestClass* object = new TestClass(8963);
   ki::Set(env, binding, "object", object,
                         "method", &TestClass::Method,
-                        "data", &TestClass::Data);
+                        "data", &TestClass::Data,
+                        "methodFn", ki::Fn<&TestClass::Method>(),
+                        "dataFn", ki::Fn<&TestClass::Data>());
+
+  std::string suffix = "64";
+  ki::Set(env, binding,
+          "statelessLambda", [](int a, int b) { return a + b; },
+          "capturingLambda", [suffix](std::string prefix) {
+            return prefix + suffix;
+          },
+          "lambdaMethod", ki::MemberFunction([](TestClass* self) {
+            return self->Data();
+          }));
 
   ki::Set(env, binding, "storeWeakFunction", &StoreWeakFunction,
                         "runStoredFunction", &RunStoredFunction,
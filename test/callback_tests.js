@@ -2,6 +2,27 @@ exports.runTests = async (assert, binding, {runInNewScope, gcUntil, addFinalizer
   assert.deepStrictEqual(binding.returnVoid(), undefined,
                          'Callback void return value converts to undefined')
   assert.equal(binding.addOne(123), 124, 'Callback convert arg from js')
+  assert.equal(binding.addOne(123, 456, 789), 124,
+               'Callback ignores extra args')
+  assert.throws(() => { binding.addOne() },
+                {
+                  name: 'TypeError',
+                  message: 'Insufficient number of arguments.',
+                },
+                'Callback throw when args are insufficient')
+  assert.throws(() => { binding.takeIntAndCounted('string', {}) },
+                {
+                  name: 'TypeError',
+                  message: 'Error processing argument at index 0, conversion failure from String to Integer.',
+                },
+                'Callback throw for the first arg that fails')
+  assert.equal(binding.conversionCount(), 0,
+               'Callback stops converting args after first failure')
+  binding.takeIntAndCounted(1, {})
+  assert.equal(binding.conversionCount(), 1,
+               'Callback converts all args on success')
+  assert.equal(binding.argumentsLength(1, 2, 3, 4, 5, 6, 7, 8, 9), 9,
+               'Callback reads all args with Arguments')
 
   assert.throws(() => { binding.addOne('string') },
                 {
@@ -13,6 +34,50 @@ exports.runTests = async (assert, binding, {runInNewScope, gcUntil, addFinalizer
   assert.equal(binding.append64(() => '89'), '8964',
                'Callback convert js function to std::function')
 
+  const order = []
+  const sum = binding.sumCallResults((i) => {
+    Promise.resolve().then(() => order.push('microtask'))
+    order.push(i)
+    return i * 2
+  }, 4)
+  assert.equal(sum, 12, 'Callback calls js function synchronously')
+  assert.deepStrictEqual(order, [0, 1, 2, 3],
+                         'Callback does not run microtasks between sync calls')
+  // napi_make_callback would enter a new async context.
+  const {executionAsyncResource} = require('async_hooks')
+  const sameContext = await new Promise((resolve) => setImmediate(() => {
+    const caller = executionAsyncResource()
+    const results = []
+    binding.sumCallResults(() => {
+      results.push(executionAsyncResource() === caller)
+      return 0
+    }, 2)
+    resolve(results)
+  }))
+  assert.deepStrictEqual(sameContext, [true, true],
+                         'Callback called from JS keeps async context')
+
+  // Without JS on the stack, microtasks run after each call, or when the
+  // batch scope closes and before the |after| callback.
+  const callFromEventLoop = (func, count) => new Promise((resolve) => {
+    const order = []
+    func((i) => {
+      Promise.resolve().then(() => order.push('microtask'))
+      order.push(i)
+    }, count, () => {
+      order.push('after')
+      setImmediate(() => resolve(order))
+    })
+  })
+  assert.deepStrictEqual(
+      await callFromEventLoop(binding.callFromEventLoop, 3),
+      [0, 'microtask', 1, 'microtask', 2, 'microtask', 'after'],
+      'Callback runs microtasks after each call from event loop')
+  assert.deepStrictEqual(
+      await callFromEventLoop(binding.dispatchEvents, 3),
+      [0, 1, 2, 'microtask', 'microtask', 'microtask', 'after'],
+      'Callback runs microtasks when batch scope closes')
+
   assert.equal(binding.nullFunction, null,
                'Callback convert null function to null')
 
@@ -20,6 +85,25 @@ exports.runTests = async (assert, binding, {runInNewScope, gcUntil, addFinalizer
   assert.equal(binding.data.call(binding.object), 8964,
                'Callback convert member function to js')
 
+  assert.equal(binding.addOneFn(123), 124,
+               'Callback convert compile-time bound function to js')
+  binding.methodFn.call(binding.object, 2)
+  assert.equal(binding.dataFn.call(binding.object), 8966,
+               'Callback convert compile-time bound member function to js')
+  assert.throws(() => { binding.addOneFn('string') },
+                {
+                  name: 'TypeError',
+                  message: 'Error processing argument at index 0, conversion failure from String to Integer.',
+                },
+                'Callback throw when arg of compile-time bound function does not match')
+
+  assert.equal(binding.statelessLambda(89, 64), 153,
+               'Callback convert stateless lambda to js')
+  assert.equal(binding.capturingLambda('89'), '8964',
+               'Callback convert capturing lambda to js')
+  assert.equal(binding.lambdaMethod.call(binding.object), 8966,
+               'Callback convert stateless lambda to member function')
+
   assert.throws(() => { binding.method() },
                 {
                   name: 'TypeError',
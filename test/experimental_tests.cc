@@ -0,0 +1,88 @@
+// Copyright (c) zcbenz.
+// Licensed under the MIT License.
+
+// Built as a separate module with NAPI_EXPERIMENTAL defined, which changes the
+// signatures of finalizers and enables the experimental APIs.
+#include <kizunapi.h>
+
+namespace {
+
+// Mutable storage of static strings, external strings read from it directly.
+char g_latin1[] = "static";
+char16_t g_utf16[] = u"static";
+
+ki::StaticString GetStaticString() {
+  return ki::StaticString(g_latin1, sizeof(g_latin1) - 1);
+}
+
+ki::StaticString GetStaticU16String() {
+  return ki::StaticString(g_utf16, sizeof(g_utf16) / sizeof(char16_t) - 1);
+}
+
+void SetStaticStringsChar(uint32_t index, uint8_t c) {
+  g_latin1[index] = static_cast<char>(c);
+  g_utf16[index] = c;
+}
+
+ki::ExternalString CreateExternalString(std::string str) {
+  return ki::ExternalString(std::move(str));
+}
+
+ki::ExternalString CreateExternalU16String(std::u16string str) {
+  return ki::ExternalString(std::move(str));
+}
+
+int g_wrapped_count = 0;
+
+class Wrapped {
+ public:
+  Wrapped() { g_wrapped_count++; }
+  ~Wrapped() { g_wrapped_count--; }
+};
+
+int GetWrappedCount() {
+  return g_wrapped_count;
+}
+
+ki::OwnedBuffer<uint8_t> OwnedBytes() {
+  return ki::OwnedBuffer<uint8_t>(std::vector<uint8_t>{1, 2, 3});
+}
+
+}  // namespace
+
+namespace ki {
+
+template<>
+struct Type<Wrapped> {
+  static constexpr const char* name = "Wrapped";
+  static Wrapped* Constructor() {
+    return new Wrapped;
+  }
+  static void Destructor(Wrapped* ptr) {
+    delete ptr;
+  }
+};
+
+}  // namespace ki
+
+napi_value Init(napi_env env, napi_value exports) {
+  napi_value binding = ki::CreateObject(env);
+  ki::Set(env, exports, "experimental", binding);
+#if defined(NODE_API_EXPERIMENTAL_HAS_EXTERNAL_STRINGS)
+  ki::Set(env, binding, "hasExternalStrings", true);
+#else
+  ki::Set(env, binding, "hasExternalStrings", false);
+#endif
+  ki::Set(env, binding,
+          "getStaticString", &GetStaticString,
+          "getStaticU16String", &GetStaticU16String,
+          "setStaticStringsChar", &SetStaticStringsChar,
+          "createExternalString", &CreateExternalString,
+          "createExternalU16String", &CreateExternalU16String,
+          "Wrapped", ki::Class<Wrapped>(),
+          "getWrappedCount", &GetWrappedCount,
+          "ownedBytes", &OwnedBytes);
+  return exports;
+}
+
+NAPI_MODULE(NODE_GYP_MODULE_NAME, Init);
@@ -0,0 +1,37 @@
+exports.runTests = async (assert, binding, {runInNewScope, gcUntil}) => {
+  const str = binding.getStaticString()
+  const u16str = binding.getStaticU16String()
+  assert.equal(str, 'static', 'StaticString with NAPI_EXPERIMENTAL')
+  assert.equal(u16str, 'static', 'u16 StaticString with NAPI_EXPERIMENTAL')
+  // External strings read the static storage without copying, older versions
+  // of Node do not have external strings and the strings are copied.
+  if (binding.hasExternalStrings) {
+    binding.setStaticStringsChar(0, 'S'.charCodeAt(0))
+    assert.equal(binding.getStaticString(), 'Static',
+                 'StaticString reads current data')
+    assert.equal(str[0] + u16str[0], 'SS', 'External strings are not copied')
+    binding.setStaticStringsChar(0, 's'.charCodeAt(0))
+  }
+
+  // Create strings and collect them to run the finalizers.
+  await runInNewScope(() => {
+    let allPassed = true
+    for (let i = 1; i <= 100; ++i) {
+      if (binding.createExternalString('e'.repeat(i)) != 'e'.repeat(i) ||
+          binding.createExternalU16String('外'.repeat(i)) != '外'.repeat(i))
+        allPassed = false
+    }
+    assert.ok(allPassed, 'ExternalString with NAPI_EXPERIMENTAL')
+  })
+  gc()
+
+  assert.deepStrictEqual(binding.ownedBytes(), Buffer.from([1, 2, 3]),
+                         'OwnedBuffer with NAPI_EXPERIMENTAL')
+  await runInNewScope(() => {
+    new binding.Wrapped()
+    assert.equal(binding.getWrappedCount(), 1, 'Wrapped is constructed')
+  })
+  await gcUntil(() => binding.getWrappedCount() == 0)
+  assert.equal(binding.getWrappedCount(), 0,
+               'Wrapped is finalized with NAPI_EXPERIMENTAL')
+}
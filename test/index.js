@@ -3,6 +3,8 @@ const path = require('path')
 const assert = require('tapsert')
 
 const bindings = require('./build/Debug/ki_tests')
+// Tests built with NAPI_EXPERIMENTAL are in a separate module.
+Object.assign(bindings, require('./build/Debug/ki_experimental_tests'))
 
 main().catch(e => {
   console.log(e)
@@ -13,7 +13,8 @@ void AddFinalizer(napi_env env, napi_value object,
                   std::function<void()> callback) {
   auto holder = std::make_unique<std::function<void()>>(std::move(callback));
   napi_status s = napi_add_finalizer(env, object, holder.get(),
-                                     [](napi_env, void* ptr, void*) {
+                                     [](ki::internal::FinalizerEnv,
+                                        void* ptr, void*) {
     auto* func = static_cast<std::function<void()>*>(ptr);
     (*func)();
     delete func;
@@ -45,12 +46,16 @@ napi_value Init(napi_env env, napi_value exports) {
   ki::Set(env, exports,
           "addFinalizer", &AddFinalizer,
           "getAttachedTable", &GetAttachedTable);
+  TEST(async);
   TEST(callback);
   TEST(persistent);
   TEST(property);
   TEST(prototype);
+  TEST(task_runner);
+  TEST(threadsafe_function);
   TEST(types);
   TEST(wrap_method);
+  TEST(wrapper_table);
   return exports;
 }
 
@@ -16,6 +16,8 @@ void Setter(int n) {
 }
 
 struct SimpleMember {
+  int Data() const { return data; }
+
   int data = 89;
   std::function<void()> callback;
 };
@@ -37,6 +39,7 @@ struct Type<SimpleMember> {
                      Property("getter", Getter(&SimpleMember::data)),
                      Property("setter", Setter(&SimpleMember::data)),
                      Property("data", &SimpleMember::data),
+                     Property("dataFn", Getter(Fn<&SimpleMember::Data>())),
                      Property("callback", Setter(&SimpleMember::callback,
                                                  FunctionArgumentIsWeakRef)));
   }
@@ -74,7 +77,10 @@ void run_property_tests(napi_env env, napi_value binding) {
   ki::DefineProperties(
       env, binding,
       ki::Property("value", ki::ToNodeValue(env, "value")),
-      ki::Property("number", ki::Getter(&Getter), ki::Setter(&Setter)));
+      ki::Property("number", ki::Getter(&Getter), ki::Setter(&Setter)),
+      ki::Property("numberFn",
+                   ki::Getter(ki::Fn<&Getter>()),
+                   ki::Setter(ki::Fn<&Setter>())));
   ki::Set(env, binding,
           "member", new SimpleMember,
           "HasObjectMember", ki::Class<HasObjectMember>());
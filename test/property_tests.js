@@ -12,6 +12,10 @@ exports.runTests = async (assert, binding, {runInNewScope, gcUntil, addFinalizer
   assert.equal(binding.number, 90,
                'Property setter defaults to not configurable')
 
+  binding.numberFn = 8963
+  assert.equal(binding.numberFn, 8964,
+               'Property compile-time bound getter and setter')
+
   let callbackCollected
   runInNewScope(() => {
     const callback = () => {}
@@ -31,6 +35,8 @@ exports.runTests = async (assert, binding, {runInNewScope, gcUntil, addFinalizer
   member.data = 8964
   assert.equal(member.data, 8964,
                'Property member data pointer to getter and setter')
+  assert.equal(member.dataFn, 8964,
+               'Property compile-time bound member function getter')
 
   const {HasObjectMember} = binding
   const has = new HasObjectMember
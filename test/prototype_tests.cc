@@ -132,6 +132,72 @@ class Copiable {
 // static
 int Copiable::count_ = 0;
 
+class TreeNode : public ki::Wrappable {
+ public:
+  TreeNode() = default;
+
+  TreeNode& operator=(const TreeNode&) = delete;
+  TreeNode(const TreeNode&) = delete;
+
+  void AddRef() {
+    count_++;
+  }
+
+  void Release() {
+    if (--count_ == 0)
+      delete this;
+  }
+
+  TreeNode* GetChild() {
+    if (!child_) {
+      child_ = new TreeNode;
+      child_->AddRef();
+    }
+    return child_;
+  }
+
+ private:
+  ~TreeNode() {
+    if (child_)
+      child_->Release();
+  }
+
+  TreeNode* child_ = nullptr;
+  int count_ = 0;
+};
+
+// A node shared by all envs, which is wrapped in workers concurrently.
+TreeNode* GetSharedTreeNode() {
+  static TreeNode* node = [] {
+    TreeNode* node = new TreeNode;
+    node->AddRef();
+    return node;
+  }();
+  return node;
+}
+
+// A Wrappable exposed to JS as Widget and WidgetView, which are unrelated
+// types in JS.
+class Widget : public ki::Wrappable {};
+class WidgetView : public Widget {};
+
+WidgetView* GetWidgetView() {
+  static WidgetView view;
+  return &view;
+}
+
+Widget* GetWidget() {
+  return GetWidgetView();
+}
+
+bool IsWidgetView(WidgetView* view) {
+  return view == GetWidgetView();
+}
+
+size_t GetWrappersCount(napi_env env) {
+  return ki::InstanceData::Get(env)->GetWrappersCount();
+}
+
 template<typename T>
 int64_t PointerOf(T* ptr) {
   return reinterpret_cast<int64_t>(ptr);;
@@ -142,6 +208,13 @@ T PassThrough(T val) {
   return val;
 }
 
+// Wrap the object with raw Node-API, which should not be read by kizunapi.
+napi_value WrapWithRawNapi(napi_env env, napi_value object) {
+  static int data = 0;
+  napi_wrap(env, object, &data, nullptr, nullptr, nullptr);
+  return object;
+}
+
 }  // namespace
 
 namespace ki {
@@ -196,6 +269,49 @@ struct TypeBridge<T, typename std::enable_if<std::is_base_of<
   }
 };
 
+template<>
+struct TypeBridge<TreeNode> {
+  static TreeNode* Wrap(TreeNode* ptr) {
+    ptr->AddRef();
+    return ptr;
+  }
+  static void Finalize(TreeNode* ptr) {
+    ptr->Release();
+  }
+};
+
+template<>
+struct Type<TreeNode> {
+  static constexpr const char* name = "TreeNode";
+  static TreeNode* Constructor() {
+    return new TreeNode;
+  }
+  static void Define(napi_env env, napi_value, napi_value prototype) {
+    Set(env, prototype, "child", &TreeNode::GetChild);
+  }
+};
+
+// The widgets are static and never freed.
+template<typename T>
+struct TypeBridge<T, typename std::enable_if<std::is_base_of<
+                         Widget, T>::value>::type> {
+  static T* Wrap(T* ptr) {
+    return ptr;
+  }
+  static void Finalize(T* ptr) {
+  }
+};
+
+template<>
+struct Type<Widget> {
+  static constexpr const char* name = "Widget";
+};
+
+template<>
+struct Type<WidgetView> {
+  static constexpr const char* name = "WidgetView";
+};
+
 template<>
 struct Type<Parent> {
   static constexpr const char* name = "Parent";
@@ -288,13 +404,24 @@ void run_prototype_tests(napi_env env, napi_value binding) {
           "Parent", ki::Class<Parent>(),
           "childToParent", &ChildToParent,
           "pointerOfParent", &PointerOf<Parent>,
-          "pointerOfChild", &PointerOf<Child>);
+          "pointerOfChild", &PointerOf<Child>,
+          "wrapWithRawNapi", &WrapWithRawNapi);
 
   WeakFactory* factory = new WeakFactory;
   ki::Set(env, binding,
           "weakFactory", factory,
           "WeakFactory", ki::Class<WeakFactory>());
 
+  ki::Set(env, binding,
+          "TreeNode", ki::Class<TreeNode>(),
+          "getSharedTreeNode", &GetSharedTreeNode,
+          "Widget", ki::Class<Widget>(),
+          "WidgetView", ki::Class<WidgetView>(),
+          "getWidget", &GetWidget,
+          "getWidgetView", &GetWidgetView,
+          "isWidgetView", &IsWidgetView,
+          "getWrappersCount", &GetWrappersCount);
+
   ki::Set(env, binding,
           "Copiable", ki::Class<Copiable>(),
           "passThroughCopiable", &PassThrough<Copiable>);
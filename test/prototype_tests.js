@@ -56,6 +56,21 @@ exports.runTests = async (assert, binding, {runInNewScope, gcUntil, addFinalizer
   assert.equal(child.parentMethod(), 89,
                'Prototype child can call parent method')
 
+  class JSChild extends Child {}
+  assert.equal(pointerOfParent(new JSChild) > 0, true,
+               'Prototype JS subclass of child can convert to parent')
+  const spoofed = new RefCounted
+  Object.setPrototypeOf(spoofed, Child.prototype)
+  assert.throws(() => { pointerOfParent(spoofed) },
+                {
+                  name: 'TypeError',
+                  message: 'Error processing argument at index 0, conversion failure from Child to Parent.',
+                },
+                'Prototype checks native type instead of prototype chain')
+  assert.throws(() => { pointerOfParent(binding.wrapWithRawNapi({})) },
+                /conversion failure from Object to Parent/,
+                'Prototype rejects objects wrapped by other modules')
+
   const {childToParent} = binding
   const sameChild = childToParent(child)
   assert.ok(sameChild instanceof Child,
@@ -78,6 +93,37 @@ exports.runTests = async (assert, binding, {runInNewScope, gcUntil, addFinalizer
   await gcUntil(() => weakFactoryCollected)
   assert.ok(true, 'Prototype wrap and unwrap internal pointer from js')
 
+  const {TreeNode, getWrappersCount} = binding
+  const wrappersCount = getWrappersCount()
+  const root = new TreeNode
+  let treeChildCollected = false
+  runInNewScope(() => {
+    const treeChild = root.child()
+    assert.ok(treeChild instanceof TreeNode, 'Wrappable converts to JS')
+    assert.equal(root.child(), treeChild,
+                 'Wrappable keeps identity of wrapper')
+    assert.equal(treeChild.child().child(), treeChild.child().child(),
+                 'Wrappable keeps identity of nested wrappers')
+    assert.equal(getWrappersCount(), wrappersCount,
+                 'Wrappable does not store wrappers in registry')
+    addFinalizer(treeChild, () => treeChildCollected = true)
+  })
+  await gcUntil(() => treeChildCollected)
+  assert.ok(root.child() instanceof TreeNode,
+            'Wrappable creates new wrapper after old one is collected')
+
+  const {Widget, WidgetView, getWidget, getWidgetView, isWidgetView} = binding
+  const widget = getWidget()
+  const widgetView = getWidgetView()
+  assert.ok(widget instanceof Widget && widgetView instanceof WidgetView,
+            'Wrappable exposed as unrelated types has a wrapper for each type')
+  assert.equal(getWidget(), widget,
+               'Wrappable keeps identity of wrapper of first type')
+  assert.equal(getWidgetView(), widgetView,
+               'Wrappable keeps identity of wrapper of second type')
+  assert.ok(isWidgetView(widgetView),
+            'Wrappable converts back from wrapper of second type')
+
   const {Copiable, passThroughCopiable} = binding
 
   let copiableCollected
@@ -91,4 +137,53 @@ exports.runTests = async (assert, binding, {runInNewScope, gcUntil, addFinalizer
 
   passThroughCopiable(new Copiable)
   assert.equal(Copiable.count(), 2, 'Prototype convert value to C++')
+
+  // Each worker has its own env and instance data, and the env of a finished
+  // worker may be reused by the next one.
+  const {Worker} = require('worker_threads')
+  const code = `
+    const {parentPort} = require('worker_threads')
+    const {prototype} = require(${JSON.stringify(require.resolve('./build/Debug/ki_tests'))})
+    const child = new prototype.Child
+    parentPort.postMessage(prototype.childToParent(child) === child &&
+                           child instanceof prototype.Parent)
+  `
+  for (let i = 0; i < 3; ++i) {
+    const result = await new Promise((resolve, reject) => {
+      const worker = new Worker(code, {eval: true})
+      worker.on('message', resolve)
+      worker.on('error', reject)
+    })
+    assert.equal(result, true, `Prototype works in worker ${i}`)
+  }
+  const child2 = new Child
+  assert.equal(childToParent(child2), child2,
+               'Prototype still works in main thread after workers')
+
+  // Only one env can store the wrapper of the shared node inline, and others
+  // store it in their registries.
+  const sharedCode = `
+    const {parentPort} = require('worker_threads')
+    const {prototype} = require(${JSON.stringify(require.resolve('./build/Debug/ki_tests'))})
+    let sameWrapper = true
+    for (let i = 0; i < 1000; ++i) {
+      const node = prototype.getSharedTreeNode()
+      if (!(node instanceof prototype.TreeNode) ||
+          node !== prototype.getSharedTreeNode())
+        sameWrapper = false
+    }
+    parentPort.postMessage(sameWrapper)
+  `
+  const sharedNode = binding.getSharedTreeNode()
+  const results = await Promise.all([0, 1, 2, 3].map(() => {
+    return new Promise((resolve, reject) => {
+      const worker = new Worker(sharedCode, {eval: true})
+      worker.on('message', resolve)
+      worker.on('error', reject)
+    })
+  }))
+  assert.deepStrictEqual(results, [true, true, true, true],
+                         'Wrappable is wrapped in workers concurrently')
+  assert.equal(binding.getSharedTreeNode(), sharedNode,
+               'Wrappable keeps identity of wrapper after workers')
 }
@@ -0,0 +1,49 @@
+// Copyright (c) zcbenz.
+// Licensed under the MIT License.
+
+#include <kizunapi.h>
+
+#include <thread>
+
+namespace {
+
+// Only accessed on the JS thread.
+std::vector<int> g_results;
+std::optional<ki::Persistent> g_done;
+
+void RunDone(napi_env env) {
+  napi_value done = g_done->Value();
+  g_done.reset();
+  napi_value results = ki::ToNodeValue(env, std::move(g_results));
+  g_results.clear();
+  napi_value ret;
+  napi_call_function(env, ki::Undefined(env), done, 1, &results, &ret);
+}
+
+void PostTasksFromThread(napi_env env, int count, napi_value done) {
+  g_done.emplace(env, done);
+  ki::TaskRunner runner = ki::GetTaskRunner(env);
+  std::thread([env, runner, count]() {
+    for (int i = 0; i < count; ++i)
+      runner.PostTask([i]() { g_results.push_back(i); });
+    ki::PostTask(env, [env]() { RunDone(env); });
+  }).detach();
+}
+
+void PostKeyedTasks(napi_env env, napi_value done) {
+  static int key;
+  g_done.emplace(env, done);
+  ki::TaskRunner runner = ki::GetTaskRunner(env);
+  runner.PostTask(&key, []() { g_results.push_back(1); });
+  runner.PostTask([]() { g_results.push_back(2); });
+  runner.PostTask(&key, []() { g_results.push_back(3); });
+  runner.PostTask([env]() { RunDone(env); });
+}
+
+}  // namespace
+
+void run_task_runner_tests(napi_env env, napi_value binding) {
+  ki::Set(env, binding,
+          "postTasksFromThread", &PostTasksFromThread,
+          "postKeyedTasks", &PostKeyedTasks);
+}
@@ -0,0 +1,12 @@
+exports.runTests = async (assert, binding) => {
+  let results = await new Promise((resolve) => {
+    binding.postTasksFromThread(1000, resolve)
+  })
+  assert.deepEqual(results, [...Array(1000).keys()],
+                   'PostTask runs tasks from other thread in order')
+
+  results = await new Promise((resolve) => {
+    binding.postKeyedTasks(resolve)
+  })
+  assert.deepEqual(results, [2, 3], 'PostTask only runs latest keyed task')
+}
@@ -0,0 +1,42 @@
+// Copyright (c) zcbenz.
+// Licensed under the MIT License.
+
+#include <kizunapi.h>
+
+#include <string>
+#include <thread>
+
+namespace {
+
+void CallInThread(int count, ki::ThreadSafeFunction<void(int)> callback) {
+  std::thread([count, callback]() {
+    for (int i = 0; i < count; ++i)
+      callback(i);
+  }).detach();
+}
+
+void CallInThreadWithBoundedQueue(napi_env env, int count, napi_value func) {
+  auto callback = ki::ThreadSafeFunction<void(int, std::string)>::Create(
+      env, func, 2);
+  std::thread([count, callback = *callback]() {
+    for (int i = 0; i < count; ++i)
+      callback.BlockingCall(i, std::to_string(i));
+  }).detach();
+}
+
+std::vector<bool> NonBlockingCalls(napi_env env, napi_value func) {
+  auto callback = ki::ThreadSafeFunction<void(int)>::Create(env, func, 2);
+  std::vector<bool> results;
+  for (int i = 0; i < 3; ++i)
+    results.push_back(callback->NonBlockingCall(i));
+  return results;
+}
+
+}  // namespace
+
+void run_threadsafe_function_tests(napi_env env, napi_value binding) {
+  ki::Set(env, binding,
+          "callInThread", &CallInThread,
+          "callInThreadWithBoundedQueue", &CallInThreadWithBoundedQueue,
+          "nonBlockingCalls", &NonBlockingCalls);
+}
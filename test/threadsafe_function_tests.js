@@ -0,0 +1,42 @@
+exports.runTests = async (assert, binding) => {
+  let received = await new Promise((resolve) => {
+    const received = []
+    binding.callInThread(100, (i) => {
+      received.push(i)
+      if (received.length == 100)
+        resolve(received)
+    })
+  })
+  assert.deepEqual(received, [...Array(100).keys()],
+                   'ThreadSafeFunction delivers calls from other thread')
+
+  received = await new Promise((resolve) => {
+    const received = []
+    binding.callInThreadWithBoundedQueue(50, (i, str) => {
+      received.push(`${i}${str}`)
+      if (received.length == 50)
+        resolve(received)
+    })
+  })
+  assert.deepEqual(received, [...Array(50).keys()].map(i => `${i}${i}`),
+                   'ThreadSafeFunction blocks on full queue')
+
+  received = []
+  let results
+  await new Promise((resolve) => {
+    results = binding.nonBlockingCalls((i) => {
+      received.push(i)
+      if (received.length == 2)
+        resolve()
+    })
+  })
+  assert.deepEqual(results, [true, true, false],
+                   'ThreadSafeFunction fails non-blocking call on full queue')
+  assert.deepEqual(received, [0, 1],
+                   'ThreadSafeFunction delivers non-blocking calls')
+
+  assert.throws(() => binding.callInThread(1, 'str'), {
+    name: 'TypeError',
+    message: 'Error processing argument at index 1, conversion failure from String to Function.',
+  }, 'ThreadSafeFunction rejects non-function')
+}
@@ -5,13 +5,131 @@
 
 namespace {
 
+struct Point {
+  int x = 0;
+  int y = 0;
+  std::optional<std::string> label;
+};
+
+struct Line {
+  Point start;
+  Point end;
+};
+
+struct Circle {
+  double radius = 0;
+};
+
+struct Rect {
+  double width = 0;
+  double height = 0;
+};
+
+constexpr char kKind[] = "kind";
+using Shape = ki::Tagged<kKind, Circle, Rect>;
+
+double ShapeArea(const Shape& shape) {
+  if (auto* circle = std::get_if<Circle>(&shape.variant()))
+    return 3 * circle->radius * circle->radius;
+  auto& rect = std::get<Rect>(shape.variant());
+  return rect.width * rect.height;
+}
+
 template<typename T>
 T Passthrough(const T& value) {
   return value;
 }
 
+double SumSpan(ki::Span<const double> span) {
+  double sum = 0;
+  for (double d : span)
+    sum += d;
+  return sum;
+}
+
+void FillSpan(ki::Span<uint8_t> span, uint8_t value) {
+  for (uint8_t& b : span)
+    b = value;
+}
+
+size_t SpanSize(ki::Span<const char> span) {
+  return span.size();
+}
+
+ki::OwnedBuffer<uint8_t> OwnedBytes() {
+  return ki::Transfer(std::vector<uint8_t>{1, 2, 3});
+}
+
+ki::OwnedBuffer<float> OwnedFloats() {
+  return ki::Transfer(std::vector<float>{0.5, 1.5});
+}
+
+ki::OwnedBuffer<double> OwnedArray() {
+  auto data = std::make_unique<double[]>(2);
+  data[0] = 89;
+  data[1] = 64;
+  return ki::OwnedBuffer<double>(std::move(data), 2);
+}
+
+std::optional<ki::OwnedBuffer<uint8_t>> OptionalOwnedBytes(bool has) {
+  if (!has)
+    return std::nullopt;
+  return ki::Transfer(std::vector<uint8_t>{4});
+}
+
+std::string PassStringView(std::string_view view) {
+  return std::string(view);
+}
+
+size_t StringViewLength(const std::string_view& view) {
+  return view.length();
+}
+
 }  // namespace
 
+namespace ki {
+
+template<>
+struct Type<Point> : Struct<Point> {
+  static constexpr const char* name = "Point";
+  static constexpr auto fields = Fields(&Point::x, "x",
+                                        &Point::y, "y",
+                                        &Point::label, "label");
+};
+
+template<>
+struct Type<Line> : Struct<Line> {
+  static constexpr const char* name = "Line";
+  static constexpr auto fields = Fields(&Line::start, "start",
+                                        &Line::end, "end");
+};
+
+template<>
+struct Type<Circle> : Struct<Circle> {
+  static constexpr const char* name = "Circle";
+  static constexpr const char* tag = "circle";
+  static constexpr auto fields = Fields(&Circle::radius, "radius");
+};
+
+template<>
+struct Type<Rect> : Struct<Rect> {
+  static constexpr const char* name = "Rect";
+  static constexpr auto fields = Fields(&Rect::width, "width",
+                                        &Rect::height, "height");
+};
+
+}  // namespace ki
+
+static_assert(ki::internal::accepted_value_types_v<int> ==
+              ki::ValueTypeMask(napi_number));
+static_assert(ki::internal::accepted_value_types_v<std::optional<bool>> ==
+              ki::ValueTypeMask(napi_boolean, napi_undefined, napi_null));
+static_assert(ki::internal::accepted_value_types_v<
+                  std::variant<std::string, Point>> ==
+              ki::ValueTypeMask(napi_string, napi_object, napi_function));
+static_assert(ki::internal::accepted_value_types_v<napi_value> ==
+              ki::kAnyValueType);
+
 void run_types_tests(napi_env env, napi_value binding) {
   ki::Set(env, binding,
           "value", ki::ToNodeValue(env, "value"),
@@ -31,5 +149,43 @@ void run_types_tests(napi_env env, napi_value binding) {
           "passTuple", &Passthrough<std::tuple<int, int>>,
           "passPair", &Passthrough<std::pair<int, int>>,
           "passVariant", &Passthrough<std::variant<float, std::string>>,
-          "passMap", &Passthrough<std::map<std::string, int>>);
+          "passMap", &Passthrough<std::map<std::string, int>>,
+          "float64Array", ki::TypedArray<double>{1.5, 2.5},
+          "uint8Array", ki::TypedArray<uint8_t>{1, 2, 255},
+          "int64Array", ki::TypedArray<int64_t>{-1, 1},
+          "passVector", &Passthrough<std::vector<int32_t>>,
+          "passTypedArray", &Passthrough<ki::TypedArray<float>>,
+          "sumSpan", &SumSpan,
+          "fillSpan", &FillSpan,
+          "spanSize", &SpanSize,
+          "ownedBytes", &OwnedBytes,
+          "ownedFloats", &OwnedFloats,
+          "ownedArray", &OwnedArray,
+          "optionalOwnedBytes", &OptionalOwnedBytes,
+          "passString", &Passthrough<std::string>,
+          "passU16String", &Passthrough<std::u16string>,
+          "passStringView", &PassStringView,
+          "stringViewLength", &StringViewLength,
+          "stringView", std::string_view("view"),
+          "staticString", ki::StaticString("static"),
+          "staticU16String", ki::StaticString(u"静的"),
+          "externalString", ki::ExternalString(std::string("外部")),
+          "externalAsciiString", ki::ExternalString(std::string(300, 'e')),
+          "externalU16String", ki::ExternalString(std::u16string(u"外部")),
+          "passBigInt64", &Passthrough<ki::BigInt<int64_t>>,
+          "passBigUint64", &Passthrough<ki::BigInt<uint64_t>>,
+          "passBigUint64Vector",
+          &Passthrough<std::vector<ki::BigInt<uint64_t>>>,
+          "point", Point{8, 9, "p"},
+          "passPoint", &Passthrough<Point>,
+          "passLine", &Passthrough<Line>,
+          "passMixedVariant",
+          &Passthrough<std::variant<std::monostate, std::string, double,
+                                    std::vector<int>, Point>>,
+          "passOptionalInt", &Passthrough<std::optional<int>>,
+          "passOptionalVariant",
+          &Passthrough<std::optional<std::variant<bool, napi_value>>>,
+          "circle", Shape(Circle{2}),
+          "passShape", &Passthrough<Shape>,
+          "shapeArea", &ShapeArea);
 }
@@ -23,6 +23,160 @@ exports.runTests = (assert, binding) => {
   assert.throws(() => binding.passVariant(false),
                 /Error processing argument at index 0/,
                 'FromNode variant throws')
+  assert.equal(binding.passMixedVariant(undefined), undefined,
+               'FromNode variant monostate')
+  assert.equal(binding.passMixedVariant('s'), 's', 'FromNode variant string')
+  assert.equal(binding.passMixedVariant(1.5), 1.5, 'FromNode variant double')
+  assert.deepStrictEqual(binding.passMixedVariant([1, 2]), [1, 2],
+                         'FromNode variant vector')
+  assert.deepStrictEqual(binding.passMixedVariant({x: 1}),
+                         {x: 1, y: 0, label: undefined},
+                         'FromNode variant struct after failed vector')
+  assert.throws(() => binding.passMixedVariant(true),
+                /Error processing argument at index 0/,
+                'FromNode variant skips all alternatives')
+  assert.equal(binding.passOptionalInt(8), 8, 'FromNode optional int')
+  assert.equal(binding.passOptionalInt(null), undefined,
+               'FromNode optional null')
+  assert.equal(binding.passOptionalInt(), undefined,
+               'FromNode optional undefined')
+  assert.throws(() => binding.passOptionalInt('8'),
+                /Error processing argument at index 0/,
+                'FromNode optional throws')
+  assert.equal(binding.passOptionalVariant(true), true,
+               'FromNode optional variant')
+  assert.equal(binding.passOptionalVariant(null), undefined,
+               'FromNode optional variant null')
+  assert.deepStrictEqual(binding.circle, {radius: 2, kind: 'circle'},
+                         'ToNode Tagged emits tag')
+  assert.deepStrictEqual(binding.passShape({kind: 'Rect', width: 2}),
+                         {width: 2, height: 0, kind: 'Rect'},
+                         'FromNode Tagged uses name as default tag')
+  assert.equal(binding.shapeArea({kind: 'circle', radius: 2}), 12,
+               'FromNode Tagged converts matching alternative')
+  assert.equal(binding.shapeArea({kind: 'Rect', width: 2, height: 3}), 6,
+               'FromNode Tagged converts second alternative')
+  for (const kind of ['square', 'circles', 'circl', 'circleé', 1, undefined]) {
+    assert.throws(() => binding.shapeArea({kind, radius: 1}),
+                  /Error processing argument at index 0/,
+                  `FromNode Tagged rejects tag ${String(kind)}`)
+  }
+  assert.throws(() => binding.shapeArea({kind: 'circle', radius: 'big'}),
+                /Error processing argument at index 0/,
+                'FromNode Tagged rejects wrong field')
   assert.deepStrictEqual(binding.passMap({'str': 123}), {'str': 123},
                          'FromNode map')
+  assert.deepStrictEqual(binding.float64Array, new Float64Array([1.5, 2.5]),
+                         'ToNode TypedArray<double>')
+  assert.deepStrictEqual(binding.uint8Array, new Uint8Array([1, 2, 255]),
+                         'ToNode TypedArray<uint8_t>')
+  assert.deepStrictEqual(binding.int64Array, new BigInt64Array([-1n, 1n]),
+                         'ToNode TypedArray<int64_t>')
+  assert.deepStrictEqual(binding.passVector(new Int32Array([1, -2, 3])),
+                         [1, -2, 3], 'FromNode vector from TypedArray')
+  const subarray = new Int32Array([1, 2, 3, 4]).subarray(1, 3)
+  assert.deepStrictEqual(binding.passVector(subarray), [2, 3],
+                         'FromNode vector from TypedArray with offset')
+  assert.throws(() => binding.passVector(new Float32Array([1])),
+                /Error processing argument at index 0/,
+                'FromNode vector rejects mismatched TypedArray')
+  assert.deepStrictEqual(binding.passTypedArray(new Float32Array([0.5])),
+                         new Float32Array([0.5]), 'FromNode TypedArray')
+  assert.deepStrictEqual(binding.passTypedArray([0.5, 1]),
+                         new Float32Array([0.5, 1]),
+                         'FromNode TypedArray from Array')
+  assert.equal(binding.sumSpan(new Float64Array([1, 2, 3])), 6,
+               'FromNode Span from TypedArray')
+  assert.equal(binding.sumSpan(new Float64Array([1, 2]).buffer), 3,
+               'FromNode Span from ArrayBuffer')
+  assert.equal(binding.sumSpan(new DataView(new Float64Array([1, 2]).buffer, 8)),
+               2, 'FromNode Span from DataView')
+  assert.throws(() => binding.sumSpan(new Float32Array([1, 2])),
+                /Error processing argument at index 0/,
+                'FromNode Span checks element type')
+  assert.throws(() => binding.sumSpan(new DataView(new ArrayBuffer(16), 1, 8)),
+                /Error processing argument at index 0/,
+                'FromNode Span checks alignment')
+  assert.throws(() => binding.sumSpan(new ArrayBuffer(12)),
+                /Error processing argument at index 0/,
+                'FromNode Span checks length')
+  const buffer = Buffer.alloc(4)
+  binding.fillSpan(buffer, 7)
+  assert.deepStrictEqual([...buffer], [7, 7, 7, 7],
+                         'FromNode Span writes to Buffer')
+  assert.equal(binding.spanSize(new Uint32Array(3)), 12,
+               'FromNode byte Span from any TypedArray')
+  assert.deepStrictEqual(binding.ownedBytes(), Buffer.from([1, 2, 3]),
+                         'ToNode OwnedBuffer<uint8_t>')
+  assert.deepStrictEqual(binding.ownedFloats(), new Float32Array([0.5, 1.5]),
+                         'ToNode OwnedBuffer<float>')
+  assert.deepStrictEqual(binding.ownedArray(), new Float64Array([89, 64]),
+                         'ToNode OwnedBuffer from unique_ptr')
+  assert.deepStrictEqual(binding.optionalOwnedBytes(true), Buffer.from([4]),
+                         'ToNode optional OwnedBuffer')
+  assert.equal(binding.optionalOwnedBytes(false), undefined,
+               'ToNode empty optional OwnedBuffer')
+  let allPassed = true
+  for (const char of ['a', '字', '😀']) {
+    for (let i = 0; i < 300; ++i) {
+      const str = 'x'.repeat(i) + char.repeat(3)
+      if (binding.passString(str) !== str ||
+          binding.passU16String(str) !== str ||
+          binding.passStringView(str) !== str) {
+        allPassed = false
+      }
+    }
+  }
+  assert.ok(allPassed, 'FromNode strings of various lengths')
+  allPassed = true
+  for (let i = 0; i < 70; ++i) {
+    const str = 'a'.repeat(i) + 'é' + 'b'.repeat(70 - i)
+    if (binding.passString(str) !== str || binding.passString(str + i) !== str + i)
+      allPassed = false
+  }
+  assert.ok(allPassed, 'ToNode non-ASCII string at various positions')
+  assert.equal(binding.stringViewLength('字'.repeat(1000)), 3000,
+               'FromNode long string_view')
+  assert.throws(() => binding.passStringView(123), {
+    name: 'TypeError',
+    message: 'Error processing argument at index 0, conversion failure from Number to String.',
+  }, 'FromNode string_view throws')
+  assert.equal(binding.stringView, 'view', 'ToNode string_view')
+  assert.equal(binding.staticString, 'static', 'ToNode StaticString')
+  assert.equal(binding.staticU16String, '静的', 'ToNode u16 StaticString')
+  assert.equal(binding.externalString, '外部', 'ToNode ExternalString')
+  assert.equal(binding.externalAsciiString, 'e'.repeat(300),
+               'ToNode ASCII ExternalString')
+  assert.equal(binding.externalU16String, '外部', 'ToNode u16 ExternalString')
+  assert.equal(binding.passBigInt64(-(2n ** 63n)), -(2n ** 63n),
+               'BigInt<int64_t> is lossless')
+  assert.equal(binding.passBigUint64(2n ** 64n - 1n), 2n ** 64n - 1n,
+               'BigInt<uint64_t> is lossless')
+  assert.equal(binding.passBigInt64(89), 89n, 'BigInt accepts Number')
+  assert.throws(() => binding.passBigInt64(2n ** 63n),
+                /Error processing argument at index 0/,
+                'BigInt rejects lossy conversion')
+  const ids = new BigUint64Array([1n, 2n ** 64n - 1n])
+  assert.deepStrictEqual(binding.passBigUint64Vector(ids), ids,
+                         'vector<BigInt> converts BigUint64Array')
+  assert.deepStrictEqual(binding.passBigUint64Vector([1n, 2]),
+                         new BigUint64Array([1n, 2n]),
+                         'vector<BigInt> converts Array')
+  assert.deepStrictEqual(binding.point, {x: 8, y: 9, label: 'p'},
+                         'ToNode Struct')
+  assert.deepStrictEqual(Object.keys(binding.passPoint({label: 'l', y: 1, x: 2})),
+                         ['x', 'y', 'label'], 'ToNode Struct keeps field order')
+  assert.deepStrictEqual(binding.passPoint({x: 1}),
+                         {x: 1, y: 0, label: undefined},
+                         'FromNode Struct keeps default of missing fields')
+  assert.deepStrictEqual(binding.passLine({start: {x: 1}, end: {y: 2}}),
+                         {start: {x: 1, y: 0, label: undefined},
+                          end: {x: 0, y: 2, label: undefined}},
+                         'FromNode nested Struct')
+  assert.throws(() => binding.passPoint({x: 'str'}),
+                /Error processing argument at index 0/,
+                'FromNode Struct rejects wrong field type')
+  assert.throws(() => binding.passPoint(123),
+                /Error processing argument at index 0/,
+                'FromNode Struct rejects non-object')
 }
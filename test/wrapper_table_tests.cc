@@ -0,0 +1,57 @@
+// Copyright (c) zcbenz.
+// Licensed under the MIT License.
+
+#include <kizunapi.h>
+
+#include <map>
+#include <random>
+
+namespace {
+
+napi_ref FakeRef(uintptr_t i) {
+  return reinterpret_cast<napi_ref>(i + 1);
+}
+
+// Compare the table with std::map after random insertions and removals.
+bool MatchesMap(uint32_t operations) {
+  static const char types[2] = {0, 0};
+  ki::internal::WrapperTable table;
+  std::map<std::pair<const void*, void*>, napi_ref> expected;
+  std::mt19937 random(8964);
+  for (uint32_t i = 0; i < operations; ++i) {
+    const void* type = &types[random() % 2];
+    // Use aligned addresses in a small range to cause collisions.
+    void* ptr = reinterpret_cast<void*>((random() % 512 + 1) * 16);
+    auto key = std::make_pair(type, ptr);
+    bool exists = expected.find(key) != expected.end();
+    if (random() % 3 == 0) {
+      napi_ref removed = table.Remove(type, ptr);
+      if (removed != (exists ? expected[key] : nullptr))
+        return false;
+      expected.erase(key);
+    } else {
+      if (table.Add(type, ptr, FakeRef(i)) == exists)
+        return false;
+      expected.emplace(key, FakeRef(i));
+    }
+    if (table.size() != expected.size())
+      return false;
+  }
+  for (const auto& [key, ref] : expected) {
+    if (table.Get(key.first, key.second) != ref)
+      return false;
+  }
+  // Remove everything to test shrinking.
+  for (const auto& [key, ref] : expected) {
+    if (table.Remove(key.first, key.second) != ref)
+      return false;
+  }
+  return table.size() == 0 && !table.Get(&types[0], nullptr);
+}
+
+}  // namespace
+
+void run_wrapper_table_tests(napi_env env, napi_value binding) {
+  ki::Set(env, binding,
+          "matchesMap", &MatchesMap);
+}
@@ -0,0 +1,4 @@
+exports.runTests = (assert, binding) => {
+  assert.ok(binding.matchesMap(100000),
+            'WrapperTable matches std::map after random operations')
+}